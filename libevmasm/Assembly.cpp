@@ -34,25 +34,54 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #include <fmt/format.h>
 
+#include <boost/container_hash/hash.hpp>
+
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/drop_exactly.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/map.hpp>
 
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <iterator>
+#include <optional>
+#include <unordered_map>
 
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Hashes the parts of the assembly items in [@a _begin, @a _end) that are compared by AssemblyItem::operator==.
+size_t hashItems(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+{
+	size_t seed = 0;
+	for (auto item = _begin; item != _end; ++item)
+	{
+		boost::hash_combine(seed, item->type());
+		if (item->type() == Operation)
+			boost::hash_combine(seed, item->instruction());
+		else if (item->type() == VerbatimBytecode)
+			boost::hash_range(seed, item->verbatimData().begin(), item->verbatimData().end());
+		else
+			boost::hash_combine(seed, item->data());
+	}
+	return seed;
+}
+
+}
+
 std::map<std::string, std::shared_ptr<std::string const>> Assembly::s_sharedSourceNames;
+std::mutex Assembly::s_sharedSourceNamesMutex;
 
 AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
@@ -644,6 +673,7 @@ void Assembly::encodeAllPossibleSubPathsInAssemblyTree(std::vector<size_t> _path
 
 std::shared_ptr<std::string const> Assembly::sharedSourceName(std::string const& _name) const
 {
+	std::lock_guard lock(s_sharedSourceNamesMutex);
 	if (s_sharedSourceNames.find(_name) == s_sharedSourceNames.end())
 		s_sharedSourceNames[_name] = std::make_shared<std::string>(_name);
 
@@ -699,20 +729,39 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
-	// Run optimisation for sub-assemblies.
+	m_minimalTagPushes = _settings.minimalTagPushes;
+
+	// Run optimisation for sub-assemblies. They only depend on the tags of this assembly
+	// referencing them, so they can be optimised concurrently and the replacements are
+	// applied afterwards, in the same order as if they were optimised one after another.
+	std::vector<std::set<size_t>> tagsReferencedFromHere;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		tagsReferencedFromHere.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	OptimiserSettings settings = _settings;
+	size_t jobs = 1;
+	if (_settings.jobs > 1 && m_subs.size() > 1 && subsOptimisableIndependently())
 	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
+		jobs = _settings.jobs;
+		settings.jobs = std::max<size_t>(_settings.jobs / m_subs.size(), 1);
+	}
+	std::vector<std::map<u256, u256> const*> subTagReplacements(m_subs.size());
+	util::parallelFor(m_subs.size(), jobs, [&](size_t _subId) {
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(
 			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+			std::move(tagsReferencedFromHere[_subId])
 		);
+	});
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		BlockDeduplicator::applyTagReplacement(m_items, *subTagReplacements[subId], subId);
 
 	std::map<u256, u256> tagReplacements;
+	// Chunks the common subexpression eliminator could not shorten in the previous iteration, by
+	// the hash of their items. The eliminator only looks at the items of a chunk and at whether
+	// MSIZE is used, so it is not run on them again. Only the chunks of the previous iteration are
+	// kept, which bounds the size of the map by the size of the assembly.
+	std::unordered_multimap<size_t, AssemblyItems> unimprovableChunks;
+	std::optional<bool> unimprovableChunksUseMSize;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -737,11 +786,8 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		if (_settings.runPeephole)
 		{
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
@@ -781,12 +827,41 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			if (unimprovableChunksUseMSize != usesMSize)
+				unimprovableChunks.clear();
+			unimprovableChunksUseMSize = usesMSize;
+			std::unordered_multimap<size_t, AssemblyItems> stillUnimprovableChunks;
+			// @returns the entry of @a _chunks with the items in [@a _begin, @a _end) or the end of @a _chunks.
+			auto findChunk = [](auto& _chunks, size_t _hash, auto _begin, auto _end) {
+				auto [candidate, candidatesEnd] = _chunks.equal_range(_hash);
+				for (; candidate != candidatesEnd; ++candidate)
+					if (std::equal(_begin, _end, candidate->second.begin(), candidate->second.end()))
+						return candidate;
+				return _chunks.end();
+			};
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
+				auto orig = iter;
+				auto chunkEnd = CommonSubexpressionEliminator::chunkEnd(orig, m_items.end(), usesMSize);
+				size_t const chunkHash = hashItems(orig, chunkEnd);
+				bool unimprovable = findChunk(stillUnimprovableChunks, chunkHash, orig, chunkEnd) != stillUnimprovableChunks.end();
+				if (!unimprovable)
+					if (auto known = findChunk(unimprovableChunks, chunkHash, orig, chunkEnd); known != unimprovableChunks.end())
+					{
+						stillUnimprovableChunks.insert(unimprovableChunks.extract(known));
+						unimprovable = true;
+					}
+				if (unimprovable)
+				{
+					copy(orig, chunkEnd, back_inserter(optimisedItems));
+					iter = chunkEnd;
+					continue;
+				}
+
 				KnownState emptyState;
 				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
 				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
@@ -812,8 +887,12 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 					optimisedItems += optimisedChunk;
 				}
 				else
+				{
 					copy(orig, iter, back_inserter(optimisedItems));
+					stillUnimprovableChunks.emplace(chunkHash, AssemblyItems(orig, iter));
+				}
 			}
+			unimprovableChunks = std::move(stillUnimprovableChunks);
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = std::move(optimisedItems);
@@ -834,6 +913,27 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	return *m_tagReplacements;
 }
 
+bool Assembly::subsOptimisableIndependently() const
+{
+	// Assemblies that are already optimised are only read, so they can be shared.
+	std::set<Assembly const*> pending;
+	std::function<bool(Assembly const&)> collectPending = [&](Assembly const& _assembly) -> bool
+	{
+		if (_assembly.m_tagReplacements)
+			return true;
+		if (!pending.insert(&_assembly).second)
+			return false;
+		for (auto const& sub: _assembly.m_subs)
+			if (!collectPending(*sub))
+				return false;
+		return true;
+	};
+	for (auto const& sub: m_subs)
+		if (!collectPending(*sub))
+			return false;
+	return true;
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
@@ -884,7 +984,7 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = std::vector<size_t>(m_usedTags, std::numeric_limits<size_t>::max());
-	std::map<size_t, std::pair<size_t, size_t>> tagRef;
+	std::map<size_t, std::tuple<size_t, size_t, unsigned>> tagRef; ///< Sub id, tag id and width of the tag pushes
 	std::multimap<h256, unsigned> dataRef;
 	std::multimap<size_t, size_t> subRef;
 	std::vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -901,7 +1001,6 @@ LinkerObject const& Assembly::assemble() const
 			assertThrow(subTagPosition != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
 			bytesPerTag = std::max(bytesPerTag, numberEncodingSize(subTagPosition));
 		}
-	uint8_t tagPush = static_cast<uint8_t>(pushInstruction(bytesPerTag));
 
 	unsigned bytesRequiredIncludingData = bytesRequiredForCode + 1 + static_cast<unsigned>(m_auxiliaryData.size());
 	for (auto const& sub: m_subs)
@@ -911,7 +1010,12 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
-	for (AssemblyItem const& i: m_items)
+	std::vector<unsigned> tagPushWidths =
+		m_minimalTagPushes ?
+		minimalTagPushWidths(bytesPerDataRef, immutableReferencesBySub) :
+		std::vector<unsigned>(m_items.size(), bytesPerTag);
+
+	for (auto&& [index, i]: m_items | ranges::views::enumerate)
 	{
 		// store position of the invalid jump destination
 		if (i.type() != Tag && m_tagPositionsInBytecode[0] == std::numeric_limits<size_t>::max())
@@ -940,9 +1044,11 @@ LinkerObject const& Assembly::assemble() const
 		}
 		case PushTag:
 		{
-			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
-			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
+			unsigned width = tagPushWidths[index];
+			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(width)));
+			auto [subId, tagId] = i.splitForeignPushTag();
+			tagRef[ret.bytecode.size()] = {subId, tagId, width};
+			ret.bytecode.resize(ret.bytecode.size() + width);
 			break;
 		}
 		case PushData:
@@ -1073,7 +1179,8 @@ LinkerObject const& Assembly::assemble() const
 	{
 		size_t subId;
 		size_t tagId;
-		std::tie(subId, tagId) = i.second;
+		unsigned width;
+		std::tie(subId, tagId, width) = i.second;
 		assertThrow(subId == std::numeric_limits<size_t>::max() || subId < m_subs.size(), AssemblyException, "Invalid sub id");
 		std::vector<size_t> const& tagPositions =
 			subId == std::numeric_limits<size_t>::max() ?
@@ -1082,8 +1189,8 @@ LinkerObject const& Assembly::assemble() const
 		assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
 		size_t pos = tagPositions[tagId];
 		assertThrow(pos != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
-		assertThrow(numberEncodingSize(pos) <= bytesPerTag, AssemblyException, "Tag too large for reserved space.");
-		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
+		assertThrow(numberEncodingSize(pos) <= width, AssemblyException, "Tag too large for reserved space.");
+		bytesRef r(ret.bytecode.data() + i.first, width);
 		toBigEndian(pos, r);
 	}
 	for (auto const& [name, tagInfo]: m_namedTags)
@@ -1128,6 +1235,101 @@ LinkerObject const& Assembly::assemble() const
 	return ret;
 }
 
+std::vector<unsigned> Assembly::minimalTagPushWidths(
+	unsigned _bytesPerDataRef,
+	std::map<u256, std::pair<std::string, std::vector<size_t>>> const& _immutableReferencesBySub
+) const
+{
+	// Sizes of the items as emitted by assemble(), not counting the data of the tag pushes.
+	std::vector<size_t> itemSizes;
+	std::vector<unsigned> widths(m_items.size(), 0);
+	itemSizes.reserve(m_items.size());
+	for (auto&& [index, item]: m_items | ranges::views::enumerate)
+		switch (item.type())
+		{
+		case Push:
+		{
+			unsigned b = numberEncodingSize(item.data());
+			if (b == 0 && !m_evmVersion.hasPush0())
+				b = 1;
+			itemSizes.push_back(1 + b);
+			break;
+		}
+		case PushTag:
+		{
+			itemSizes.push_back(1);
+			widths[index] = 1;
+			auto [subId, tagId] = item.splitForeignPushTag();
+			if (subId != std::numeric_limits<size_t>::max())
+			{
+				// Tags of sub-assemblies do not move anymore.
+				assertThrow(subId < m_subs.size(), AssemblyException, "Invalid sub id");
+				size_t subTagPosition = m_subs[subId]->m_tagPositionsInBytecode.at(tagId);
+				assertThrow(subTagPosition != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+				widths[index] = std::max(1u, numberEncodingSize(subTagPosition));
+			}
+			break;
+		}
+		case PushSubSize:
+		{
+			assertThrow(item.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
+			size_t subSize = subAssemblyById(static_cast<size_t>(item.data()))->assemble().bytecode.size();
+			itemSizes.push_back(1 + std::max<size_t>(1, numberEncodingSize(subSize)));
+			break;
+		}
+		case AssignImmutable:
+		{
+			auto references = _immutableReferencesBySub.find(item.data());
+			if (references == _immutableReferencesBySub.end() || references->second.second.empty())
+				itemSizes.push_back(2);
+			else
+			{
+				auto const& offsets = references->second.second;
+				// (DUP2 DUP2 PUSH <offset> ADD MSTORE)* PUSH <offset> ADD MSTORE
+				size_t size = 2 * (offsets.size() - 1);
+				for (size_t offset: offsets)
+					size += 3 + numberEncodingSize(offset);
+				itemSizes.push_back(size);
+			}
+			break;
+		}
+		default:
+			itemSizes.push_back(item.bytesRequired(_bytesPerDataRef));
+			break;
+		}
+
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		std::vector<size_t> tagPositions(m_usedTags, std::numeric_limits<size_t>::max());
+		size_t position = 0;
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+		{
+			if (item.type() != Tag && tagPositions[0] == std::numeric_limits<size_t>::max())
+				tagPositions[0] = position;
+			if (item.type() == Tag)
+				tagPositions.at(static_cast<size_t>(item.data())) = position;
+			position += itemSizes[index] + widths[index];
+		}
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == PushTag)
+			{
+				auto [subId, tagId] = item.splitForeignPushTag();
+				if (subId != std::numeric_limits<size_t>::max())
+					continue;
+				assertThrow(tagId < tagPositions.size(), AssemblyException, "Reference to non-existing tag.");
+				assertThrow(tagPositions[tagId] != std::numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+				unsigned width = std::max(1u, numberEncodingSize(tagPositions[tagId]));
+				if (width > widths[index])
+				{
+					widths[index] = width;
+					changed = true;
+				}
+			}
+	}
+	return widths;
+}
+
 std::vector<size_t> Assembly::decodeSubPath(size_t _subObjectId) const
 {
 	if (_subObjectId < m_subs.size())
@@ -1176,10 +1378,14 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 	return currentAssembly;
 }
 
-Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
+Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(
+	frontend::OptimiserSettings const& _settings,
+	langutil::EVMVersion const& _evmVersion,
+	size_t _jobs
+)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0, _jobs, false};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -1187,6 +1393,7 @@ Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(front
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.minimalTagPushes = _settings.minimalTagPushes;
 	asmSettings.evmVersion = _evmVersion;
 	return asmSettings;
 }
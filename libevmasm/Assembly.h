@@ -38,6 +38,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <utility>
 
 namespace solidity::evmasm
@@ -128,8 +129,18 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
-
-		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
+		/// Maximum number of threads used to optimise independent sub-assemblies concurrently.
+		/// Does not influence the result.
+		size_t jobs = 1;
+		/// Push every tag with the smallest width its position needs instead of using the same
+		/// width for all tags, see @a assemble.
+		bool minimalTagPushes = false;
+
+		static OptimiserSettings translateSettings(
+			frontend::OptimiserSettings const& _settings,
+			langutil::EVMVersion const& _evmVersion,
+			size_t _jobs = 1
+		);
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -180,8 +191,18 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns true if every assembly below this one that still has to be optimised is reachable
+	/// on only one path, so that the sub-assemblies can be optimised concurrently.
+	bool subsOptimisableIndependently() const;
 
 	unsigned codeSize(unsigned subTagSize) const;
+	/// @returns the width of every tag push in m_items (zero for all other items), chosen as small as
+	/// possible for the final tag positions. Widening a push moves the tags behind it, so the widths
+	/// are increased until all of them fit.
+	std::vector<unsigned> minimalTagPushWidths(
+		unsigned _bytesPerDataRef,
+		std::map<u256, std::pair<std::string, std::vector<size_t>>> const& _immutableReferencesBySub
+	) const;
 
 	/// Add all assembly items from given JSON array. This function imports the items by iterating through
 	/// the code array. This method only works on clean Assembly objects that don't have any items defined yet.
@@ -238,6 +259,8 @@ protected:
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
 
 	langutil::EVMVersion m_evmVersion;
+	/// Set by the optimiser, makes @a assemble use the smallest width for every tag push.
+	bool m_minimalTagPushes = false;
 
 	int m_deposit = 0;
 	/// True, if the assembly contains contract creation code.
@@ -249,6 +272,7 @@ protected:
 
 	// FIXME: This being static means that the strings won't be freed when they're no longer needed
 	static std::map<std::string, std::shared_ptr<std::string const>> s_sharedSourceNames;
+	static std::mutex s_sharedSourceNamesMutex;
 
 public:
 	size_t m_currentModifierDepth = 0;
@@ -74,7 +74,7 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 	switch (type())
 	{
 	case Operation:
-		return {instructionInfo(instruction(), _evmVersion).name, m_data != nullptr ? toStringInHex(*m_data) : ""};
+		return {instructionInfo(instruction(), _evmVersion).name, ""};
 	case Push:
 		return {"PUSH", toStringInHex(data())};
 	case PushTag:
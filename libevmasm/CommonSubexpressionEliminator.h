@@ -73,6 +73,9 @@ public:
 	/// @param _msizeImportant if false, do not consider modification of MSIZE a side-effect
 	template <class AssemblyItemIterator>
 	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+	/// @returns the iterator @a feedItems would return for the same arguments, without analysing the items.
+	template <class AssemblyItemIterator>
+	static AssemblyItemIterator chunkEnd(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
 
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
@@ -90,6 +93,8 @@ private:
 	/// number with what instruction.
 	std::vector<StoreOperation> m_storeOperations;
 
+	static unsigned constexpr c_maxChunkSize = 2000;
+
 	/// The item that breaks the basic block, can be nullptr.
 	/// It is usually appended to the block but can be optimized in some cases.
 	AssemblyItem const* m_breakingItem = nullptr;
@@ -179,17 +184,35 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
-	unsigned const maxChunkSize = 2000;
 	unsigned chunkSize = 0;
 	for (
 		;
-		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < maxChunkSize;
+		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < c_maxChunkSize;
 		++_iterator, ++chunkSize
 	)
 		feedItem(*_iterator);
-	if (_iterator != _end && chunkSize < maxChunkSize)
+	if (_iterator != _end && chunkSize < c_maxChunkSize)
 		m_breakingItem = &(*_iterator++);
 	return _iterator;
 }
 
+template <class AssemblyItemIterator>
+AssemblyItemIterator CommonSubexpressionEliminator::chunkEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
+	unsigned chunkSize = 0;
+	for (
+		;
+		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < c_maxChunkSize;
+		++_iterator, ++chunkSize
+	)
+		;
+	if (_iterator != _end && chunkSize < c_maxChunkSize)
+		++_iterator;
+	return _iterator;
+}
+
 }
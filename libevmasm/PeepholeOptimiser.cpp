@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <limits>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -76,18 +78,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity>
-{
-	static bool applySimple(
-		AssemblyItem const& _item,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
 	static bool applySimple(
@@ -457,20 +447,24 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static bool endsBlock(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
 		auto end = _state.items.end();
 		if (it == end)
 			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		if (!endsBlock(it[0]))
 			return false;
 
 		ptrdiff_t i = 1;
@@ -487,21 +481,153 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// Applies the first rule matching the items at the beginning of @a _state.items.
+/// @returns false if no rule matches, i.e. the first item is kept as it is.
+bool applyRules(OptimiserState& _state)
+{
+	return applyMethods(
+		_state,
+		PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+		DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
+		TagConjunctions(), TruthyAnd()
+	);
+}
+
+/// Maximum number of items a rule depends on. UnreachableCode removes more items,
+/// but whether it applies only depends on the first two.
+size_t constexpr c_maxWindowSize = 5;
+
+/// The items as a doubly linked list, so that the rules can replace items in place and
+/// the replacements of a pass that is not kept can be undone.
+class ItemList
+{
+public:
+	static size_t constexpr none = std::numeric_limits<size_t>::max();
+
+	explicit ItemList(AssemblyItems const& _items)
+	{
+		m_nodes.reserve(_items.size());
+		for (AssemblyItem const& item: _items)
+			m_nodes.push_back({item, m_nodes.empty() ? none : m_nodes.size() - 1, m_nodes.size() + 1, false});
+		if (!m_nodes.empty())
+			m_nodes.back().next = none;
+		m_first = m_nodes.empty() ? none : 0;
+	}
+
+	size_t first() const { return m_first; }
+	size_t next(size_t _node) const { return m_nodes[_node].next; }
+	size_t previous(size_t _node) const { return m_nodes[_node].previous; }
+	AssemblyItem const& item(size_t _node) const { return m_nodes[_node].item; }
+	bool removed(size_t _node) const { return m_nodes[_node].removed; }
+
+	/// Copies the items starting at @a _node into @a _window, as many as a rule can depend on
+	/// and everything UnreachableCode would remove.
+	void window(size_t _node, AssemblyItems& _window) const
+	{
+		_window.clear();
+		bool const endsBlock = UnreachableCode::endsBlock(item(_node));
+		for (size_t node = _node; node != none; node = next(node))
+		{
+			if (_window.size() >= c_maxWindowSize && (!endsBlock || item(node).type() == Tag))
+				break;
+			_window.push_back(item(node));
+		}
+	}
+
+	/// Replaces the @a _count items starting at @a _node by @a _replacement.
+	/// @returns the last inserted node or, if nothing is inserted, the node before @a _node.
+	size_t replace(size_t _node, size_t _count, AssemblyItems const& _replacement)
+	{
+		Replacement replacement{previous(_node), _node, _node, none};
+		for (size_t i = 0; i < _count; ++i)
+		{
+			replacement.last = i == 0 ? _node : next(replacement.last);
+			m_nodes[replacement.last].removed = true;
+		}
+		replacement.after = next(replacement.last);
+		m_replacements.push_back(replacement);
+
+		size_t last = replacement.before;
+		for (AssemblyItem const& item: _replacement)
+		{
+			m_nodes.push_back({item, last, none, false});
+			link(last, m_nodes.size() - 1);
+			last = m_nodes.size() - 1;
+		}
+		link(last, replacement.after);
+		return last;
+	}
+
+	size_t replacementCount() const { return m_replacements.size(); }
+
+	/// Undoes the replacements until only @a _count of them are left.
+	void undoReplacements(size_t _count)
+	{
+		for (; m_replacements.size() > _count; m_replacements.pop_back())
+		{
+			Replacement const& replacement = m_replacements.back();
+			link(replacement.before, replacement.first);
+			link(replacement.last, replacement.after);
+			for (size_t node = replacement.first; node != replacement.after; node = next(node))
+				m_nodes[node].removed = false;
+		}
+	}
+
+	AssemblyItems items() const
+	{
+		AssemblyItems items;
+		for (size_t node = m_first; node != none; node = next(node))
+			items.push_back(item(node));
+		return items;
+	}
+
+private:
+	struct Node
+	{
+		AssemblyItem item;
+		size_t previous;
+		size_t next;
+		bool removed;
+	};
+
+	/// The nodes from @a first to @a last were replaced, they were linked to @a before and @a after.
+	struct Replacement
+	{
+		size_t before;
+		size_t first;
+		size_t last;
+		size_t after;
+	};
+
+	void link(size_t _node, size_t _next)
+	{
+		if (_node == none)
+			m_first = _next;
+		else
+			m_nodes[_node].next = _next;
+		if (_next != none)
+			m_nodes[_next].previous = _node;
+	}
+
+	std::vector<Node> m_nodes;
+	size_t m_first = none;
+	std::vector<Replacement> m_replacements;
+};
+
+ptrdiff_t numberOfPops(AssemblyItems const& _items)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	return static_cast<ptrdiff_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
 }
 
 }
@@ -510,24 +636,90 @@ bool PeepholeOptimiser::optimise()
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
-		)
-	))
+	auto const bytesRequired = [&](AssemblyItems const& _items) {
+		return static_cast<ptrdiff_t>(evmasm::bytesRequired(_items, 3, approx));
+	};
+
+	ItemList list{m_items};
+	// In a pass, every item that is not removed by a rule applied to an earlier item is examined.
+	// An item for which no rule matched is only examined again in the next pass if one of the items
+	// its rules depend on was replaced. Otherwise no rule matches again, so skipping it does not
+	// change the result of the pass.
+	std::vector<size_t> toExamine;
+	for (size_t node = list.first(); node != ItemList::none; node = list.next(node))
+		toExamine.push_back(node);
+	std::vector<size_t> examinedInPass(m_items.size(), 1);
+
+	bool changed = false;
+	AssemblyItems window;
+	AssemblyItems replacement;
+	for (size_t pass = 1; !toExamine.empty(); ++pass)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		assertThrow(pass < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
+
+		std::vector<size_t> toExamineNext;
+		auto const examineInNextPass = [&](size_t _node) {
+			if (examinedInPass.size() <= _node)
+				examinedInPass.resize(_node + 1, 0);
+			if (examinedInPass[_node] != pass + 1)
+			{
+				examinedInPass[_node] = pass + 1;
+				toExamineNext.push_back(_node);
+			}
+		};
+
+		size_t const replacementsBefore = list.replacementCount();
+		ptrdiff_t sizeChange = 0;
+		ptrdiff_t bytesChange = 0;
+		ptrdiff_t popsChange = 0;
+		for (size_t node: toExamine)
+		{
+			if (list.removed(node))
+				continue;
+
+			list.window(node, window);
+			replacement.clear();
+			OptimiserState state{window, 0, back_inserter(replacement)};
+			if (!applyRules(state))
+				continue;
+
+			AssemblyItems const removed(window.begin(), window.begin() + static_cast<ptrdiff_t>(state.i));
+			sizeChange += static_cast<ptrdiff_t>(replacement.size()) - static_cast<ptrdiff_t>(removed.size());
+			bytesChange += bytesRequired(replacement) - bytesRequired(removed);
+			popsChange += numberOfPops(replacement) - numberOfPops(removed);
+
+			size_t last = list.replace(node, state.i, replacement);
+			if (last == ItemList::none)
+				continue;
+			// The replacement and the items before it whose rules can depend on it are examined again.
+			size_t first = last;
+			for (size_t i = 0; i < replacement.size() + c_maxWindowSize - 2 && list.previous(first) != ItemList::none; ++i)
+				first = list.previous(first);
+			for (size_t item = first; item != list.next(last); item = list.next(item))
+				examineInNextPass(item);
+		}
+
+		// Only keep the pass if it made the code smaller.
+		if (!(
+			sizeChange < 0 ||
+			(sizeChange == 0 && (bytesChange < 0 || popsChange > 0))
+		))
+		{
+			list.undoReplacements(replacementsBefore);
+			break;
+		}
+
+		changed = true;
+		if (m_examineAllItems)
+		{
+			toExamineNext.clear();
+			for (size_t node = list.first(); node != ItemList::none; node = list.next(node))
+				toExamineNext.push_back(node);
+		}
+		toExamine = std::move(toExamineNext);
 	}
-	else
-		return false;
+
+	if (changed)
+		m_items = list.items();
+	return changed;
 }
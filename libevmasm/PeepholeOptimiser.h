@@ -38,17 +38,29 @@ public:
 	virtual bool apply(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out);
 };
 
+/**
+ * Applies the peephole rules to the items until no rule applies anymore.
+ *
+ * The result is the same as repeatedly applying the rules in passes over all items from
+ * left to right, each pass only being kept if it makes the code smaller, but after the first
+ * pass only the items near a change made by the previous pass are examined again.
+ */
 class PeepholeOptimiser
 {
 public:
-	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
+	/// If @a _examineAllItems is set, every pass examines all items again. This gives the same
+	/// result more slowly and is only used to test that skipping items does not change it.
+	explicit PeepholeOptimiser(AssemblyItems& _items, bool _examineAllItems = false):
+		m_items(_items), m_examineAllItems(_examineAllItems)
+	{}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
+	bool m_examineAllItems = false;
 };
 
 }
@@ -65,6 +65,43 @@
 namespace solidity::langutil
 {
 
+namespace
+{
+
+/// Classes of characters that are skipped in bulk by Scanner::advanceOver.
+enum CharacterClass: uint8_t
+{
+	WhiteSpace = 1,
+	IdentifierPart = 2,
+	YulIdentifierPart = 4,
+	/// Characters that cannot start a line break inside a single-line comment.
+	SingleLineCommentPart = 8,
+	/// Characters that cannot start the end of a multi-line comment.
+	MultiLineCommentPart = 16
+};
+
+constexpr std::array<uint8_t, 256> characterClasses = []() {
+	std::array<uint8_t, 256> classes{};
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		char c = static_cast<char>(i);
+		if (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+			classes[i] |= WhiteSpace;
+		if (c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9'))
+			classes[i] |= IdentifierPart | YulIdentifierPart;
+		if (c == '.')
+			classes[i] |= YulIdentifierPart;
+		// Line feed to carriage return and the first bytes of the UTF-8 encoded NEL, LS and PS.
+		if (!(0x0a <= i && i <= 0x0d) && i != 0xc2 && i != 0xe2)
+			classes[i] |= SingleLineCommentPart;
+		if (c != '*')
+			classes[i] |= MultiLineCommentPart;
+	}
+	return classes;
+}();
+
+}
+
 std::string to_string(ScannerError _errorCode)
 {
 	switch (_errorCode)
@@ -245,11 +282,28 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+size_t Scanner::advanceOver(uint8_t _classes)
+{
+	std::string const& source = m_source.source();
+	size_t const start = m_source.position();
+	size_t end = start;
+	while (end < source.size() && (characterClasses[static_cast<uint8_t>(source[end])] & _classes))
+		++end;
+	if (end != start)
+		m_char = m_source.advanceAndGet(end - start);
+	return end - start;
+}
+
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
+	// m_char is not always the character at the current position, e.g. after a multi-line
+	// comment, so it is checked before skipping the rest in bulk.
 	while (isWhiteSpace(m_char))
+	{
 		advance();
+		advanceOver(WhiteSpace);
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -312,7 +366,7 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
 	while (!isUnicodeLinebreak())
-		if (!advance())
+		if (!advanceOver(SingleLineCommentPart) && !advance())
 			break;
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
@@ -393,6 +447,11 @@ Token Scanner::skipMultiLineComment()
 	size_t startPosition = m_source.position();
 	while (!isSourcePastEndOfInput())
 	{
+		// Only a '*' can start the end of the comment.
+		if (m_char != '*')
+			advanceOver(MultiLineCommentPart);
+		if (isSourcePastEndOfInput())
+			break;
 		char prevChar = m_char;
 		advance();
 
@@ -1016,8 +1075,9 @@ std::tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	size_t const start = sourcePos();
+	size_t const length = advanceOver(m_kind == ScannerKind::Yul ? YulIdentifierPart : IdentifierPart);
+	m_tokens[NextNext].literal.append(m_source.source(), start, length);
 	literal.complete();
 
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
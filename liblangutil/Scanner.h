@@ -204,6 +204,11 @@ private:
 	///@}
 
 	bool advance() { m_char = m_source.advanceAndGet(); return !m_source.isPastEndOfInput(); }
+	/// Advances over all characters of the source, starting at the current position, that are
+	/// in one of the character classes @a _classes (see Scanner.cpp).
+	/// Unlike calling advance() for each of them, this does not look at m_char.
+	/// @returns the number of characters skipped.
+	size_t advanceOver(uint8_t _classes);
 	void rollback(size_t _amount) { m_char = m_source.rollback(_amount); }
 	/// Rolls back to the start of the current token and re-runs the scanner.
 	void rescan();
@@ -44,7 +44,10 @@
 #include <liblangutil/Token.h>
 #include <libsolutil/StringUtils.h>
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 namespace solidity::langutil
 {
@@ -134,17 +137,70 @@ std::string friendlyName(Token tok)
 }
 
 
-static Token keywordByName(std::string const& _name)
+namespace
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
+
+struct Keyword
+{
+	std::string_view name;
+	Token token;
+};
+
+// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+// and keywords to be put inside the keywords variable.
+#define KEYWORD(name, string, precedence) Keyword{string, Token::name},
 #define TOKEN(name, string, precedence)
-	static std::map<std::string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+constexpr Keyword keywords[] = {TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+
+constexpr size_t keywordCount = sizeof(keywords) / sizeof(keywords[0]);
+constexpr size_t keywordTableSize = 256;
+static_assert(keywordCount < keywordTableSize / 2, "Keyword table too full.");
+
+/// FNV-1a hash of the name, reduced to a slot of the keyword table.
+constexpr size_t keywordSlot(std::string_view _name)
+{
+	uint32_t hash = 2166136261u;
+	for (char c: _name)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 16777619u;
+	}
+	return hash % keywordTableSize;
+}
+
+/// Open addressing hash table built at compile time. Every slot holds the index of a keyword
+/// plus one, or zero if it is empty.
+constexpr std::array<uint8_t, keywordTableSize> keywordTable = []() {
+	std::array<uint8_t, keywordTableSize> table{};
+	for (size_t index = 0; index < keywordCount; ++index)
+	{
+		size_t slot = keywordSlot(keywords[index].name);
+		while (table[slot] != 0)
+			slot = (slot + 1) % keywordTableSize;
+		table[slot] = static_cast<uint8_t>(index + 1);
+	}
+	return table;
+}();
+
+constexpr size_t maxKeywordLength = []() {
+	size_t length = 0;
+	for (Keyword const& keyword: keywords)
+		length = std::max(length, keyword.name.size());
+	return length;
+}();
+
+}
+
+static Token keywordByName(std::string_view _name)
+{
+	if (_name.size() > maxKeywordLength)
+		return Token::Identifier;
+	for (size_t slot = keywordSlot(_name); keywordTable[slot] != 0; slot = (slot + 1) % keywordTableSize)
+		if (keywords[keywordTable[slot] - 1].name == _name)
+			return keywords[keywordTable[slot] - 1].token;
+	return Token::Identifier;
 }
 
 bool isYulKeyword(std::string const& _literal)
@@ -183,7 +239,7 @@ std::tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(std::strin
 	auto positionM = find_if(_literal.begin(), _literal.end(), util::isDigit);
 	if (positionM != _literal.end())
 	{
-		std::string baseType(_literal.begin(), positionM);
+		std::string_view baseType(_literal.data(), static_cast<size_t>(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), util::isDigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
@@ -121,6 +121,11 @@ std::pair<CheckResult, std::vector<std::string>> CVC4Interface::check(std::vecto
 	return std::make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_solver.interrupt();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
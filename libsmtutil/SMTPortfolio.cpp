@@ -26,17 +26,141 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 using namespace solidity::smtutil;
 
+class SMTPortfolio::SolverThread
+{
+public:
+	explicit SolverThread(SolverInterface& _solver):
+		m_solver(_solver),
+		m_thread([this]() { run(); })
+	{}
+
+	~SolverThread()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+			m_commands.clear();
+		}
+		m_solver.interrupt();
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	/// Queues @a _command, which changes the state of the solver, to be run after all previously
+	/// sent commands. If the command throws, the solver misses its effect, so the exception is kept
+	/// and later commands are skipped until the solver is reset.
+	void send(std::function<void(SolverInterface&)> _command)
+	{
+		enqueue([command = std::move(_command)](SolverInterface& _solver, std::exception_ptr& _failure) {
+			if (_failure)
+				return;
+			try
+			{
+				command(_solver);
+			}
+			catch (...)
+			{
+				_failure = std::current_exception();
+			}
+		});
+	}
+
+	/// Queues a reset of the solver, which also discards the exception of a failed command.
+	void sendReset()
+	{
+		enqueue([](SolverInterface& _solver, std::exception_ptr& _failure) {
+			_failure = nullptr;
+			try
+			{
+				_solver.reset();
+			}
+			catch (...)
+			{
+				_failure = std::current_exception();
+			}
+		});
+	}
+
+	/// Queues @a _query to be run after all previously sent commands. It is passed the exception
+	/// of the command that failed since the last reset, if any, instead of which it has to report
+	/// the exception. Exceptions thrown by the query itself are not caught.
+	void sendQuery(std::function<void(SolverInterface&, std::exception_ptr)> _query)
+	{
+		enqueue([query = std::move(_query)](SolverInterface& _solver, std::exception_ptr& _failure) {
+			query(_solver, _failure);
+		});
+	}
+
+	/// Waits until all commands sent so far have been run.
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [&]() { return m_commands.empty() && !m_busy; });
+	}
+
+private:
+	using Command = std::function<void(SolverInterface&, std::exception_ptr&)>;
+
+	void enqueue(Command _command)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_commands.emplace_back(std::move(_command));
+		}
+		m_condition.notify_all();
+	}
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [&]() { return m_stop || !m_commands.empty(); });
+			if (m_stop)
+				return;
+			Command command = std::move(m_commands.front());
+			m_commands.pop_front();
+			m_busy = true;
+			lock.unlock();
+			// Only accessed on this thread.
+			command(m_solver, m_failure);
+			lock.lock();
+			m_busy = false;
+			m_condition.notify_all();
+		}
+	}
+
+	SolverInterface& m_solver;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<Command> m_commands;
+	bool m_busy = false;
+	bool m_stop = false;
+	/// Exception thrown by a command since the last reset.
+	std::exception_ptr m_failure;
+	/// Declared last so that the thread starts after the other members are initialized.
+	std::thread m_thread;
+};
+
 SMTPortfolio::SMTPortfolio(
 	std::map<h256, std::string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
 	std::optional<unsigned> _queryTimeout,
-	bool _printQuery
+	bool _printQuery,
+	bool _detectConflicts
 ):
 	SolverInterface(_queryTimeout)
 {
@@ -51,37 +175,53 @@ SMTPortfolio::SMTPortfolio(
 	if (_enabledSolvers.cvc4)
 		m_solvers.emplace_back(std::make_unique<CVC4Interface>(m_queryTimeout));
 #endif
+	startSolverThreads(_detectConflicts);
 }
 
+SMTPortfolio::SMTPortfolio(
+	std::vector<std::unique_ptr<SolverInterface>> _solvers,
+	std::optional<unsigned> _queryTimeout,
+	bool _detectConflicts
+):
+	SolverInterface(_queryTimeout),
+	m_solvers(std::move(_solvers))
+{
+	startSolverThreads(_detectConflicts);
+}
+
+SMTPortfolio::~SMTPortfolio() = default;
+
 void SMTPortfolio::reset()
 {
-	for (auto const& s: m_solvers)
-		s->reset();
+	m_declarations.clear();
+	if (m_solverThreads.empty())
+		for (auto const& s: m_solvers)
+			s->reset();
+	else
+		for (auto const& thread: m_solverThreads)
+			thread->sendReset();
 }
 
 void SMTPortfolio::push()
 {
-	for (auto const& s: m_solvers)
-		s->push();
+	forEachSolver([](SolverInterface& _solver) { _solver.push(); });
 }
 
 void SMTPortfolio::pop()
 {
-	for (auto const& s: m_solvers)
-		s->pop();
+	forEachSolver([](SolverInterface& _solver) { _solver.pop(); });
 }
 
 void SMTPortfolio::declareVariable(std::string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
-	for (auto const& s: m_solvers)
-		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
+	forEachSolver([=](SolverInterface& _solver) { _solver.declareVariable(_name, _sort); });
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
-	for (auto const& s: m_solvers)
-		s->addAssertion(_expr);
+	forEachSolver([=](SolverInterface& _solver) { _solver.addAssertion(_expr); });
 }
 
 /*
@@ -113,9 +253,21 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers are queried concurrently (see the constructor), rule 2) does not apply.
+ * Instead, the first UNSAT answer is returned as soon as it arrives, since it carries no values.
+ * The same holds for a SAT answer if no expressions are to be evaluated. Otherwise, the answer of
+ * the first solver in the order of m_solvers that answers is returned, so that the values of a
+ * counterexample do not depend on which solver happens to be faster. That means waiting for the
+ * solvers before the one that answered first. As soon as the answer is known, the solvers that
+ * are still working are interrupted. A solver that missed an earlier command because it threw an
+ * exception counts as an error.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	if (!m_solverThreads.empty())
+		return checkConcurrently(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
 	for (auto const& s: m_solvers)
@@ -142,8 +294,134 @@ std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector
 	return std::make_pair(lastResult, finalValues);
 }
 
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::checkConcurrently(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	// Shared with the solver threads, since the solvers that are not needed
+	// may still be working on the query when this function returns.
+	struct Query
+	{
+		struct Outcome
+		{
+			bool finished = false;
+			CheckResult result = CheckResult::ERROR;
+			std::vector<std::string> values;
+			std::exception_ptr exception;
+		};
+		std::mutex mutex;
+		std::condition_variable finished;
+		/// Set once the result is decided. Solvers that have not started the query yet skip it.
+		bool decided = false;
+		std::vector<Outcome> outcomes;
+
+		/// @returns the index of the solver whose answer is used, if it is known already.
+		/// This is the first solver that answered if all solvers before it finished, or any
+		/// solver whose answer has no values.
+		std::optional<size_t> decisiveAnswer(bool _valuesRequested) const
+		{
+			for (size_t i = 0; i < outcomes.size() && outcomes[i].finished; ++i)
+				if (solverAnswered(outcomes[i].result))
+					return i;
+			for (size_t i = 0; i < outcomes.size(); ++i)
+				if (
+					outcomes[i].finished &&
+					(
+						outcomes[i].result == CheckResult::UNSATISFIABLE ||
+						(outcomes[i].result == CheckResult::SATISFIABLE && !_valuesRequested)
+					)
+				)
+					return i;
+			return std::nullopt;
+		}
+		bool allFinished() const
+		{
+			return std::all_of(outcomes.begin(), outcomes.end(), [](Outcome const& _outcome) { return _outcome.finished; });
+		}
+	};
+	auto query = std::make_shared<Query>();
+	query->outcomes.resize(m_solvers.size());
+
+	for (size_t index = 0; index < m_solverThreads.size(); ++index)
+		m_solverThreads[index]->sendQuery([query, index, _expressionsToEvaluate](SolverInterface& _solver, std::exception_ptr _failure) {
+			{
+				std::lock_guard<std::mutex> lock(query->mutex);
+				if (query->decided)
+				{
+					query->outcomes[index].finished = true;
+					return;
+				}
+			}
+			Query::Outcome outcome;
+			outcome.finished = true;
+			if (_failure)
+				outcome.exception = _failure;
+			else
+				try
+				{
+					tie(outcome.result, outcome.values) = _solver.check(_expressionsToEvaluate);
+				}
+				catch (...)
+				{
+					outcome.exception = std::current_exception();
+				}
+
+			std::lock_guard<std::mutex> lock(query->mutex);
+			query->outcomes[index] = std::move(outcome);
+			query->finished.notify_all();
+		});
+
+	bool const valuesRequested = !_expressionsToEvaluate.empty();
+	std::unique_lock<std::mutex> lock(query->mutex);
+	query->finished.wait(lock, [&]() { return query->decisiveAnswer(valuesRequested) || query->allFinished(); });
+	query->decided = true;
+
+	if (std::optional<size_t> answer = query->decisiveAnswer(valuesRequested))
+	{
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (!query->outcomes[i].finished)
+				m_solvers[i]->interrupt();
+		Query::Outcome& outcome = query->outcomes[*answer];
+		return std::make_pair(outcome.result, std::move(outcome.values));
+	}
+
+	// No solver answered, so all of them have finished.
+	for (Query::Outcome const& outcome: query->outcomes)
+		if (outcome.result == CheckResult::UNKNOWN)
+			return std::make_pair(CheckResult::UNKNOWN, std::vector<std::string>{});
+	for (Query::Outcome const& outcome: query->outcomes)
+		if (outcome.exception)
+			std::rethrow_exception(outcome.exception);
+	return std::make_pair(CheckResult::ERROR, std::vector<std::string>{});
+}
+
+void SMTPortfolio::forEachSolver(std::function<void(SolverInterface&)> const& _command)
+{
+	if (m_solverThreads.empty())
+		for (auto const& s: m_solvers)
+			_command(*s);
+	else
+		for (auto const& thread: m_solverThreads)
+			thread->send(_command);
+}
+
+void SMTPortfolio::waitForSolverThreads()
+{
+	for (auto const& thread: m_solverThreads)
+		thread->wait();
+}
+
+void SMTPortfolio::startSolverThreads([[maybe_unused]] bool _detectConflicts)
+{
+#ifndef __EMSCRIPTEN__
+	// The JavaScript build has no threads and its SMT callback has to run on the main thread.
+	if (m_solvers.size() > 1 && !_detectConflicts)
+		for (auto const& s: m_solvers)
+			m_solverThreads.emplace_back(std::make_unique<SolverThread>(*s));
+#endif
+}
+
 std::vector<std::string> SMTPortfolio::unhandledQueries()
 {
+	waitForSolverThreads();
 	// This code assumes that the constructor guarantees that
 	// SmtLib2Interface is in position 0, if enabled.
 	if (!m_solvers.empty())
@@ -159,6 +437,7 @@ bool SMTPortfolio::solverAnswered(CheckResult result)
 
 std::string SMTPortfolio::dumpQuery(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	waitForSolverThreads();
 	// This code assumes that the constructor guarantees that
 	// SmtLib2Interface is in position 0, if enabled.
 	auto smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
@@ -23,7 +23,10 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace solidity::smtutil
@@ -32,8 +35,18 @@ namespace solidity::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ *
+ * If more than one solver is enabled, the solvers are queried concurrently by default, each on
+ * its own thread. An unsatisfiable answer is used as soon as any solver gives it. For a satisfiable
+ * answer, the values of the counterexample are taken from the first solver in the portfolio that
+ * gives a definitive answer, so they do not depend on the timing of the threads (see check for
+ * details). Conflicting answers are not detected then. If conflict detection is requested, the
+ * solvers are queried one after another instead and the portfolio checks whether they give
+ * conflicting answers.
+ *
+ * Note that with concurrent queries, the SMTLib2 solver and thereby the SMT callback run on a
+ * thread of the portfolio instead of the thread using it. The callback of one portfolio is not
+ * called concurrently, but several portfolios may share the same callback.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -47,8 +60,16 @@ public:
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
 		std::optional<unsigned> _queryTimeout = {},
-		bool _printQuery = false
+		bool _printQuery = false,
+		bool _detectConflicts = false
 	);
+	/// Wraps the given solvers, for example to test the portfolio with custom solvers.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> _solvers,
+		std::optional<unsigned> _queryTimeout = {},
+		bool _detectConflicts = false
+	);
+	~SMTPortfolio() override;
 
 	void reset() override;
 
@@ -66,12 +87,35 @@ public:
 
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
+	/// @returns the variables declared since the last reset, in the order of declaration.
+	/// Can be used to declare them in another solver, for example one running on another thread.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
+
 private:
+	/// Runs the commands sent to one solver on a separate thread.
+	class SolverThread;
+
 	static bool solverAnswered(CheckResult result);
 
+	/// Starts a thread for each solver if they are to be queried concurrently.
+	void startSolverThreads(bool _detectConflicts);
+
+	/// Queries the solvers concurrently, see the comment on @a check.
+	std::pair<CheckResult, std::vector<std::string>> checkConcurrently(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Sends @a _command to all solvers, to be run on their threads if they have one.
+	/// On a solver thread, an exception thrown by the command is reported by the next query
+	/// of the solver instead, see SolverThread.
+	void forEachSolver(std::function<void(SolverInterface&)> const& _command);
+	/// Waits until all solver threads have run the commands sent to them.
+	void waitForSolverThreads();
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// One thread per solver if the solvers are queried concurrently, empty otherwise.
+	/// Declared after m_solvers so that the threads are stopped before the solvers are destroyed.
+	std::vector<std::unique_ptr<SolverThread>> m_solverThreads;
 
 	std::vector<Expression> m_assertions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 };
 
 }
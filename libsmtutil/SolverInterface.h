@@ -536,6 +536,11 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check running on another thread to stop as soon as possible and to return UNKNOWN.
+	/// Can be called from any thread. Has no effect on checks started afterwards.
+	/// Solvers that cannot be interrupted ignore the request.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
@@ -38,6 +38,18 @@ bool Z3Interface::available()
 #endif
 }
 
+std::string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return
+		std::to_string(major) + "." + std::to_string(minor) + "." +
+		std::to_string(build) + "." + std::to_string(revision);
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -139,6 +151,11 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 	return std::make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
@@ -34,6 +34,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the version of the Z3 library in use, e.g. "4.12.1.0".
+	static std::string version();
 
 	void reset() override;
 
@@ -44,6 +46,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -126,8 +126,11 @@ public:
 
 	virtual bool experimentalSolidityOnly() const { return false; }
 
+	friend class Parser;
+
 protected:
-	size_t const m_id = 0;
+	/// Only changed by the parser that created the node, see Parser::shiftIDs.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -37,8 +37,15 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _jobs maximum number of threads used to optimise independent sub-assemblies.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		size_t _jobs = 1
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_jobs(_jobs),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
@@ -64,6 +71,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_jobs = 1;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
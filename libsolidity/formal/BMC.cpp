@@ -25,6 +25,10 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/Parallel.h>
+
+#include <atomic>
+
 #include <utility>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -43,14 +47,29 @@ BMC::BMC(
 	std::map<h256, std::string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	std::shared_ptr<SMTQueryCache> _queryCache
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _charStreamProvider),
 	m_interface(std::make_unique<smtutil::SMTPortfolio>(
-		_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout, _settings.printQuery
-	))
+		_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout, _settings.printQuery, _settings.detectSolverConflicts
+	)),
+	m_queryCache(std::move(_queryCache))
 {
 	solAssert(!_settings.printQuery || _settings.solvers == smtutil::SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
+	// Printed queries have to appear in the order in which the targets are checked.
+	if (!_settings.printQuery)
+		for (unsigned i = 1; i < _settings.jobs; ++i)
+		{
+			m_workerSolvers.emplace_back(std::make_unique<smtutil::SMTPortfolio>(
+				_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout, false, _settings.detectSolverConflicts
+			));
+			m_workerDeclarations.emplace_back(0);
+			m_workerScopes.emplace_back();
+		}
+	m_incrementalAssertions = !_settings.solvers.smtlib2;
+	if (m_queryCache)
+		m_queryCacheContext = "bmc\n" + SMTQueryCache::solverContext(_settings.solvers, _settings.timeout);
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -127,7 +146,7 @@ void BMC::analyze(SourceUnit const& _source, std::map<ASTNode const*, std::set<V
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver, if enabled.
 	if (
-		!m_interface->unhandledQueries().empty() &&
+		!unhandledQueries().empty() &&
 		m_interface->solvers() == 1 &&
 		m_settings.solvers.smtlib2
 	)
@@ -142,6 +161,14 @@ void BMC::analyze(SourceUnit const& _source, std::map<ASTNode const*, std::set<V
 		);
 }
 
+std::vector<std::string> BMC::unhandledQueries()
+{
+	std::vector<std::string> queries = m_interface->unhandledQueries();
+	for (auto const& solver: m_workerSolvers)
+		queries += solver->unhandledQueries();
+	return queries;
+}
+
 bool BMC::shouldInlineFunctionCall(
 	FunctionCall const& _funCall,
 	ContractDefinition const* _scopeContract,
@@ -919,6 +946,7 @@ void BMC::checkVerificationTargets()
 {
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	solvePendingQueries();
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -959,6 +987,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 	checkBooleanNotConstant(
 		*_target.expression,
 		_target.constraints,
+		_target.assertions,
 		_target.value,
 		_target.callStack
 	);
@@ -1073,11 +1102,14 @@ void BMC::addVerificationTarget(
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			m_incrementalAssertions ?
+				currentPathConditions() :
+				currentPathConditions() && m_context.assertions()
 		},
 		_expression,
 		m_callStack,
-		modelExpressions()
+		modelExpressions(),
+		m_incrementalAssertions ? m_context.assertionList() : nullptr
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
 		checkVerificationTarget(target);
@@ -1099,22 +1131,154 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	std::vector<smtutil::Expression> expressionsToEvaluate;
-	std::vector<std::string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	BMCQuery query{
+		&_target,
+		std::move(_condition),
+		_target.assertions,
+		&_callStack,
+		_modelExpressions.first,
+		_modelExpressions.second,
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		std::nullopt,
+		false,
+		smtutil::CheckResult::ERROR,
+		{},
+		std::nullopt
+	};
 	if (!_callStack.empty())
 		if (_additionalValue)
 		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
+			query.expressionsToEvaluate.emplace_back(*_additionalValue);
+			query.expressionNames.push_back(_additionalValueName);
 		}
-	smtutil::CheckResult result;
-	std::vector<std::string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
 
+	query.cacheKey = queryCacheKey(query.condition, query.assertions, query.expressionsToEvaluate);
+	if (query.cacheKey)
+		if (auto cached = m_queryCache->loadSMT(*query.cacheKey))
+		{
+			tie(query.result, query.values) = std::move(*cached);
+			query.solved = true;
+		}
+
+	if (!m_workerSolvers.empty())
+	{
+		// Solved queries are queued as well, so that the results are reported in order.
+		m_pendingQueries.emplace_back(std::move(query));
+		return;
+	}
+
+	if (!query.solved)
+	{
+		assertIncrementally(*m_interface, m_interfaceScopes, query.assertions);
+		m_interface->push();
+		m_interface->addAssertion(query.condition);
+		tie(query.result, query.values) = checkSatisfiableAndGenerateModel(query.expressionsToEvaluate);
+		m_interface->pop();
+
+		if (query.cacheKey)
+			storeQueryResult(*query.cacheKey, {query.result, query.values});
+	}
+
+	reportQuery(query);
+}
+
+void BMC::solvePendingQueries()
+{
+	if (m_pendingQueries.empty())
+		return;
+
+	// Queries answered by the query cache do not need a solver.
+	size_t unsolved = 0;
+	for (BMCQuery const& query: m_pendingQueries)
+		if (!query.solved)
+			++unsolved;
+
+	auto const& declarations = dynamic_cast<smtutil::SMTPortfolio const&>(*m_interface).declarations();
+	std::vector<smtutil::SolverInterface*> solvers{m_interface.get()};
+	std::vector<SolverScopes*> scopes{&m_interfaceScopes};
+	for (size_t i = 0; i < m_workerSolvers.size() && solvers.size() < unsolved; ++i)
+	{
+		// m_interface is never reset, so its declarations only grow.
+		auto& declared = m_workerDeclarations[i];
+		solAssert(declared <= declarations.size());
+		for (; declared < declarations.size(); ++declared)
+			m_workerSolvers[i]->declareVariable(declarations[declared].first, declarations[declared].second);
+		solvers.push_back(m_workerSolvers[i].get());
+		scopes.push_back(&m_workerScopes[i]);
+	}
+
+	// Every thread checks the next query nobody has taken yet on its own solver.
+	std::atomic<size_t> nextQuery{0};
+	util::parallelFor(solvers.size(), solvers.size(), [&](size_t _solver) {
+		for (size_t i = nextQuery++; i < m_pendingQueries.size(); i = nextQuery++)
+			if (!m_pendingQueries[i].solved)
+				solveQuery(*solvers[_solver], *scopes[_solver], m_pendingQueries[i]);
+	});
+
+	for (BMCQuery const& query: m_pendingQueries)
+	{
+		if (query.cacheKey && !query.solved)
+			storeQueryResult(*query.cacheKey, {query.result, query.values});
+		if (query.solverError)
+			m_errorReporter.warning(8140_error, *query.solverError);
+		reportQuery(query);
+	}
+	m_pendingQueries.clear();
+}
+
+void BMC::assertIncrementally(
+	smtutil::SolverInterface& _solver,
+	SolverScopes& _scopes,
+	smt::EncodingContext::Assertions const& _assertions
+)
+{
+	auto depth = [](smt::EncodingContext::Assertions const& _list) { return _list ? _list->depth : 0; };
+
+	// Find the longest list of assertions that is already asserted and shared with _assertions.
+	smt::EncodingContext::Assertions common = _scopes.empty() ? nullptr : _scopes.back();
+	smt::EncodingContext::Assertions requested = _assertions;
+	while (depth(common) > depth(requested))
+		common = common->previous;
+	while (depth(requested) > depth(common))
+		requested = requested->previous;
+	while (common != requested)
+	{
+		common = common->previous;
+		requested = requested->previous;
+	}
+
+	while (!_scopes.empty() && depth(_scopes.back()) > depth(common))
+	{
+		_solver.pop();
+		_scopes.pop_back();
+	}
+
+	smt::EncodingContext::Assertions asserted = _scopes.empty() ? nullptr : _scopes.back();
+	if (asserted == _assertions)
+		return;
+
+	std::vector<smtutil::Expression const*> missing;
+	for (auto const* node = _assertions.get(); node != asserted.get(); node = node->previous.get())
+		missing.push_back(&node->assertion);
+	_solver.push();
+	for (auto assertion = missing.rbegin(); assertion != missing.rend(); ++assertion)
+		_solver.addAssertion(**assertion);
+	_scopes.push_back(_assertions);
+}
+
+void BMC::solveQuery(smtutil::SolverInterface& _solver, SolverScopes& _scopes, BMCQuery& _query)
+{
+	assertIncrementally(_solver, _scopes, _query.assertions);
+	_solver.push();
+	_solver.addAssertion(_query.condition);
+	tie(_query.result, _query.values) = querySolver(_solver, _query.expressionsToEvaluate, _query.solverError);
+	_solver.pop();
+}
+
+void BMC::reportQuery(BMCQuery const& _query)
+{
 	std::string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
 		extraComment +=
@@ -1131,64 +1295,63 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_query.result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_query.callStack->empty(), "");
 		std::ostringstream message;
-		message << "BMC: " << targetDescription(_target) << " happens here.";
+		message << "BMC: " << targetDescription(*_query.target) << " happens here.";
 
 		std::ostringstream modelMessage;
 		// Sometimes models have complex smtlib2 expressions that SMTLib2Interface fails to parse.
-		if (values.size() == expressionNames.size())
+		if (_query.values.size() == _query.expressionNames.size())
 		{
 			modelMessage << "Counterexample:\n";
 			std::map<std::string, std::string> sortedModel;
-			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+			for (size_t i = 0; i < _query.values.size(); ++i)
+				if (_query.expressionsToEvaluate.at(i).name != _query.values.at(i))
+					sortedModel[_query.expressionNames.at(i)] = _query.values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 		}
 
 		m_errorReporter.warning(
-			_errorHappens,
-			_location,
+			_query.errorHappens,
+			_query.location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(*_query.callStack))
 			.append(std::move(secondaryLocation))
 		);
 		break;
 	}
 	case smtutil::CheckResult::UNSATISFIABLE:
 	{
-		m_safeTargets[_target.expression].insert(_target);
+		m_safeTargets[_query.target->expression].insert(*_query.target);
 		break;
 	}
 	case smtutil::CheckResult::UNKNOWN:
 	{
 		++m_unprovedAmt;
 		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + targetDescription(_target) + " might happen here.", secondaryLocation);
+			m_errorReporter.warning(_query.errorMightHappen, _query.location, "BMC: " + targetDescription(*_query.target) + " might happen here.", secondaryLocation);
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _query.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _query.location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
 	Expression const& _condition,
 	smtutil::Expression const& _constraints,
+	smt::EncodingContext::Assertions const& _assertions,
 	smtutil::Expression const& _value,
 	std::vector<SMTEncoder::CallStackEntry> const& _callStack
 )
@@ -1197,15 +1360,8 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto positiveResult = checkSatisfiable(_constraints && _value, _assertions);
+	auto negatedResult = checkSatisfiable(_constraints && !_value, _assertions);
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
@@ -1246,28 +1402,41 @@ void BMC::checkBooleanNotConstant(
 
 std::pair<smtutil::CheckResult, std::vector<std::string>>
 BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate)
+{
+	if (m_settings.printQuery)
+	{
+		auto portfolio = dynamic_cast<smtutil::SMTPortfolio*>(m_interface.get());
+		std::string smtlibCode = portfolio->dumpQuery(_expressionsToEvaluate);
+		m_errorReporter.info(
+			6240_error,
+			"BMC: Requested query:\n" + smtlibCode
+		);
+	}
+	std::optional<std::string> solverError;
+	auto result = querySolver(*m_interface, _expressionsToEvaluate, solverError);
+	if (solverError)
+		m_errorReporter.warning(8140_error, *solverError);
+	return result;
+}
+
+std::pair<smtutil::CheckResult, std::vector<std::string>> BMC::querySolver(
+	smtutil::SolverInterface& _solver,
+	std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+	std::optional<std::string>& _solverError
+)
 {
 	smtutil::CheckResult result;
 	std::vector<std::string> values;
 	try
 	{
-		if (m_settings.printQuery)
-		{
-			auto portfolio = dynamic_cast<smtutil::SMTPortfolio*>(m_interface.get());
-			std::string smtlibCode = portfolio->dumpQuery(_expressionsToEvaluate);
-			m_errorReporter.info(
-				6240_error,
-				"BMC: Requested query:\n" + smtlibCode
-			);
-		}
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		std::string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
+		_solverError = std::move(description);
 		result = smtutil::CheckResult::ERROR;
 	}
 
@@ -1284,9 +1453,69 @@ BMC::checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _e
 	return make_pair(result, values);
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+smtutil::CheckResult BMC::checkSatisfiable(
+	smtutil::Expression const& _condition,
+	smt::EncodingContext::Assertions const& _assertions
+)
+{
+	std::optional<h256> cacheKey = queryCacheKey(_condition, _assertions, {});
+	if (cacheKey)
+		if (auto cached = m_queryCache->loadSMT(*cacheKey))
+			return cached->first;
+
+	assertIncrementally(*m_interface, m_interfaceScopes, _assertions);
+	m_interface->push();
+	m_interface->addAssertion(_condition);
+	auto result = checkSatisfiableAndGenerateModel({});
+	m_interface->pop();
+
+	if (cacheKey)
+		storeQueryResult(*cacheKey, result);
+	return result.first;
+}
+
+std::optional<h256> BMC::queryCacheKey(
+	smtutil::Expression const& _condition,
+	smt::EncodingContext::Assertions const& _assertions,
+	std::vector<smtutil::Expression> const& _expressionsToEvaluate
+)
+{
+	// Requested queries are always printed, so they are never taken from the cache.
+	if (!m_queryCache || m_settings.printQuery)
+		return std::nullopt;
+
+	auto const& declarations = dynamic_cast<smtutil::SMTPortfolio const&>(*m_interface).declarations();
+	solAssert(m_indexedDeclarations <= declarations.size());
+	for (; m_indexedDeclarations < declarations.size(); ++m_indexedDeclarations)
+		m_declaredNames.insert(declarations[m_indexedDeclarations].first);
+
+	// Only the declarations used by the query are part of the key, implicitly by the names of
+	// their uses, so that declarations made for unrelated functions do not change it.
+	CanonicalQuery query([&](smtutil::Expression const& _expression) {
+		return m_declaredNames.count(_expression.name) > 0;
+	});
+	std::vector<smtutil::Expression const*> assertions;
+	for (auto const* node = _assertions.get(); node; node = node->previous.get())
+		assertions.push_back(&node->assertion);
+	// Symbols are named in the order in which they are used, starting with the oldest assertion.
+	for (auto assertion = assertions.rbegin(); assertion != assertions.rend(); ++assertion)
+		query.add("assert", **assertion);
+	query.add("check", _condition);
+	for (smtutil::Expression const& expression: _expressionsToEvaluate)
+		query.add("value", expression);
+	return SMTQueryCache::key(m_queryCacheContext, query.text());
+}
+
+void BMC::storeQueryResult(
+	h256 const& _cacheKey,
+	std::pair<smtutil::CheckResult, std::vector<std::string>> const& _result
+)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	// Without a timeout the solvers linked into this binary give up on a query after a
+	// fixed amount of work, answers to SMT-LIB2 queries might be missing though.
+	bool deterministic = !m_settings.timeout && !m_settings.solvers.smtlib2;
+	if (SMTQueryCache::cacheable(_result.first, deterministic))
+		m_queryCache->storeSMT(_cacheKey, _result);
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
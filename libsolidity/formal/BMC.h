@@ -32,12 +32,15 @@
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -65,7 +68,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		std::shared_ptr<SMTQueryCache> _queryCache
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -73,7 +77,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -84,6 +88,18 @@ public:
 		ContractDefinition const* _contextContract
 	);
 
+	/// The assertions of the encoding context that are asserted in a solver. Each entry is
+	/// one solver scope and points to the last assertion added in that scope.
+	using SolverScopes = std::vector<smt::EncodingContext::Assertions>;
+	/// Makes @a _assertions the assertions of @a _solver outside of the scopes used for single
+	/// queries. Keeps the scopes of @a _scopes that only contain assertions of @a _assertions
+	/// and adds the remaining assertions in a new scope.
+	static void assertIncrementally(
+		smtutil::SolverInterface& _solver,
+		SolverScopes& _scopes,
+		smt::EncodingContext::Assertions const& _assertions
+	);
+
 private:
 	/// AST visitors.
 	/// Only nodes that lead to verification targets being built
@@ -146,6 +162,10 @@ private:
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
+		/// Assertions of the encoding context that hold together with the constraints.
+		/// Only set if they are added to the solvers incrementally, otherwise they are
+		/// part of the constraints.
+		smt::EncodingContext::Assertions assertions;
 
 		friend bool operator<(BMCVerificationTarget const& _a, BMCVerificationTarget const& _b)
 		{
@@ -172,7 +192,34 @@ private:
 
 	/// Solver related.
 	//@{
+	/// The condition of a verification target together with everything needed to report the result.
+	struct BMCQuery
+	{
+		BMCVerificationTarget const* target;
+		smtutil::Expression condition;
+		/// Assertions checked together with the condition, see BMCVerificationTarget.
+		smt::EncodingContext::Assertions assertions;
+		std::vector<CallStackEntry> const* callStack;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+
+		/// Key of the query in the query cache, if the cache is used.
+		std::optional<util::h256> cacheKey;
+
+		/// Set if the result was loaded from the query cache.
+		bool solved = false;
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Set if the solver threw an error, which is reported together with the result.
+		std::optional<std::string> solverError;
+	};
+
 	/// Check that a condition can be satisfied.
+	/// If the targets are checked on multiple threads, the check is only queued
+	/// and performed by solvePendingQueries.
 	void checkCondition(
 		BMCVerificationTarget const& _target,
 		smtutil::Expression _condition,
@@ -189,19 +236,74 @@ private:
 	void checkBooleanNotConstant(
 		Expression const& _condition,
 		smtutil::Expression const& _constraints,
+		smt::EncodingContext::Assertions const& _assertions,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
+	/// Checks the queued conditions on m_interface and the worker solvers concurrently
+	/// and reports the results in the order in which the conditions were queued.
+	void solvePendingQueries();
+	/// Checks the condition of @a _query on @a _solver and stores the result in @a _query.
+	/// Does not report anything, so it can be used on any thread.
+	static void solveQuery(smtutil::SolverInterface& _solver, SolverScopes& _scopes, BMCQuery& _query);
+	void reportQuery(BMCQuery const& _query);
+
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Checks the assertions of @a _solver and evaluates @a _expressionsToEvaluate if they are satisfiable.
+	/// Solver errors are stored in @a _solverError instead of being reported.
+	static std::pair<smtutil::CheckResult, std::vector<std::string>> querySolver(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate,
+		std::optional<std::string>& _solverError
+	);
+
+	/// Checks whether @a _condition can be satisfied together with @a _assertions.
+	/// The result is taken from the query cache if possible.
+	smtutil::CheckResult checkSatisfiable(
+		smtutil::Expression const& _condition,
+		smt::EncodingContext::Assertions const& _assertions
+	);
 
-	smtutil::CheckResult checkSatisfiable();
+	/// @returns the key under which the result of checking @a _condition together with
+	/// @a _assertions and evaluating @a _expressionsToEvaluate is stored in the query cache,
+	/// or nullopt if no cache is used.
+	std::optional<util::h256> queryCacheKey(
+		smtutil::Expression const& _condition,
+		smt::EncodingContext::Assertions const& _assertions,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
+	void storeQueryResult(
+		util::h256 const& _cacheKey,
+		std::pair<smtutil::CheckResult, std::vector<std::string>> const& _result
+	);
 	//@}
 
 	smtutil::Expression mergeVariablesFromLoopCheckpoints();
 	bool isInsideLoop() const;
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	/// Additional solvers used to check verification targets concurrently, one per extra thread.
+	std::vector<std::unique_ptr<smtutil::SMTPortfolio>> m_workerSolvers;
+	/// Number of declarations of m_interface that have already been made in each worker solver.
+	std::vector<size_t> m_workerDeclarations;
+
+	/// Whether the assertions of the encoding context are kept in the solvers across queries
+	/// instead of being sent again as part of every query. Only the solvers linked into this
+	/// binary are incremental, queries in SMT-LIB2 format are sent as a whole.
+	bool m_incrementalAssertions = false;
+	SolverScopes m_interfaceScopes;
+	std::vector<SolverScopes> m_workerScopes;
+	/// Conditions queued by checkCondition if there are worker solvers.
+	std::vector<BMCQuery> m_pendingQueries;
+
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	/// Describes the solvers and settings, part of every query cache key.
+	std::string m_queryCacheContext;
+	/// Names declared in m_interface, which are renamed in the query cache keys.
+	std::set<std::string> m_declaredNames;
+	/// Number of declarations of m_interface that have already been added to m_declaredNames.
+	size_t m_indexedDeclarations = 0;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
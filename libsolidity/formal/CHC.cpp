@@ -48,6 +48,7 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
 #include <charconv>
 #include <queue>
 
@@ -65,13 +66,22 @@ CHC::CHC(
 	std::map<util::h256, std::string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	std::shared_ptr<SMTQueryCache> _queryCache
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _unsupportedErrorReporter, _charStreamProvider),
 	m_smtlib2Responses(_smtlib2Responses),
-	m_smtCallback(_smtCallback)
+	m_smtCallback(_smtCallback),
+	m_queryCache(std::move(_queryCache))
 {
 	solAssert(!_settings.printQuery || _settings.solvers == smtutil::SMTSolverChoice::SMTLIB2(), "Only SMTLib2 solver can be enabled to print queries");
+	// Requested queries are always printed, so they are never taken from the cache.
+	if (m_queryCache && !_settings.printQuery)
+	{
+		m_queryCacheContext = "chc\n" + SMTQueryCache::solverContext(_settings.solvers, _settings.timeout);
+		if (!_settings.invariants.invariants.empty())
+			m_queryCacheContext += "invariants\n";
+	}
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -1273,6 +1283,8 @@ void CHC::resetSourceAnalysis()
 	Predicate::reset();
 	ArraySlicePredicate::reset();
 	m_blockCounter = 0;
+	m_rules.clear();
+	m_rulesByHead.clear();
 
 	// At this point every enabled solver is available.
 	// If more than one Horn solver is selected we go with z3.
@@ -1907,6 +1919,12 @@ smtutil::Expression CHC::predicate(
 void CHC::addRule(smtutil::Expression const& _rule, std::string const& _ruleName)
 {
 	m_interface->addRule(_rule, _ruleName);
+	if (!m_queryCacheContext.empty())
+	{
+		smtutil::Expression const& head = _rule.name == "=>" ? _rule.arguments.at(1) : _rule;
+		m_rulesByHead[head.name].push_back(m_rules.size());
+		m_rules.push_back(_rule);
+	}
 }
 
 std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
@@ -1924,6 +1942,16 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 			"CHC: Requested query:\n" + smtLibCode
 		);
 	}
+
+	std::optional<CanonicalQuery> cacheQuery = canonicalQuery(_query);
+	std::optional<util::h256> cacheKey;
+	if (cacheQuery)
+	{
+		cacheKey = SMTQueryCache::key(m_queryCacheContext, cacheQuery->text());
+		if (auto cached = m_queryCache->loadCHC(*cacheKey))
+			return cacheQuery->original(*cached);
+	}
+
 	std::tie(result, invariant, cex) = m_interface->query(_query);
 	switch (result)
 	{
@@ -1965,9 +1993,64 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
+
+	// Only Spacer gives up on a query after a fixed amount of work if there is no timeout.
+	if (cacheKey && SMTQueryCache::cacheable(result, !m_settings.timeout && m_settings.solvers.z3))
+		m_queryCache->storeCHC(*cacheKey, cacheQuery->canonical({result, invariant, cex}));
 	return {result, invariant, cex};
 }
 
+std::optional<CanonicalQuery> CHC::canonicalQuery(smtutil::Expression const& _query) const
+{
+	if (m_queryCacheContext.empty())
+		return std::nullopt;
+
+	// Predicates are the heads of rules, all other declared names are variables.
+	auto isSymbol = [&](smtutil::Expression const& _expression) {
+		if (m_rulesByHead.count(_expression.name))
+			return true;
+		if (!_expression.arguments.empty() || _expression.sort->kind == smtutil::Kind::Sort)
+			return false;
+		std::string const& name = _expression.name;
+		return
+			name != "true" &&
+			name != "false" &&
+			!std::all_of(name.begin(), name.end(), [](char _c) { return '0' <= _c && _c <= '9'; });
+	};
+
+	// Only the rules of the predicates the query depends on are part of the key.
+	std::set<size_t> relevantRules;
+	std::set<std::string> predicates{_query.name};
+	std::vector<std::string> toVisit{_query.name};
+	while (!toVisit.empty())
+	{
+		std::string predicate = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (!m_rulesByHead.count(predicate))
+			continue;
+		for (size_t rule: m_rulesByHead.at(predicate))
+		{
+			relevantRules.insert(rule);
+			if (m_rules[rule].name != "=>")
+				continue;
+			util::BreadthFirstSearch<smtutil::Expression const*>{{&m_rules[rule].arguments.at(0)}}.run(
+				[&](smtutil::Expression const* _expression, auto&& _addChild) {
+					if (m_rulesByHead.count(_expression->name) && predicates.insert(_expression->name).second)
+						toVisit.push_back(_expression->name);
+					for (smtutil::Expression const& argument: _expression->arguments)
+						_addChild(&argument);
+				}
+			);
+		}
+	}
+
+	CanonicalQuery query(isSymbol);
+	query.add("query", _query);
+	for (size_t rule: relevantRules)
+		query.add("rule", m_rules[rule]);
+	return query;
+}
+
 void CHC::verificationTargetEncountered(
 	ASTNode const* const _errorNode,
 	VerificationTargetType _type,
@@ -34,6 +34,7 @@
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -61,7 +62,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		std::shared_ptr<SMTQueryCache> _queryCache
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -286,6 +288,9 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// @returns the text of @a _query and of the rules it depends on, from which the key of its
+	/// result in the query cache is computed, or nullopt if no cache is used.
+	std::optional<CanonicalQuery> canonicalQuery(smtutil::Expression const& _query) const;
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -472,6 +477,15 @@ private:
 
 	std::map<util::h256, std::string> const& m_smtlib2Responses;
 	ReadCallback::Callback const& m_smtCallback;
+
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	/// Describes the solvers and settings, part of every query cache key.
+	/// Empty if no cache is used.
+	std::string m_queryCacheContext;
+	/// Rules added to m_interface since the last reset, only kept if the cache is used.
+	std::vector<smtutil::Expression> m_rules;
+	/// Indices in m_rules of the rules with a head, by the name of the predicate.
+	std::map<std::string, std::vector<size_t>> m_rulesByHead;
 };
 
 }
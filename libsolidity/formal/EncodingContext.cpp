@@ -188,15 +188,31 @@ smtutil::Expression EncodingContext::assertions()
 	if (m_assertions.empty())
 		return smtutil::Expression(true);
 
-	return m_assertions.back();
+	return conjunction(m_assertions.back());
+}
+
+smtutil::Expression EncodingContext::conjunction(Assertions const& _assertions)
+{
+	if (!_assertions)
+		return smtutil::Expression(true);
+
+	std::vector<AssertionNode const*> nodes;
+	for (AssertionNode const* node = _assertions.get(); node; node = node->previous.get())
+		nodes.push_back(node);
+
+	// Same shape as if the assertions had been conjoined when they were added.
+	smtutil::Expression result = nodes.back()->assertion;
+	for (size_t i = nodes.size() - 1; i > 0; --i)
+		result = nodes[i - 1]->assertion && std::move(result);
+	return result;
 }
 
 void EncodingContext::pushSolver()
 {
-	if (m_accumulateAssertions)
-		m_assertions.push_back(assertions());
+	if (m_accumulateAssertions && !m_assertions.empty())
+		m_assertions.push_back(m_assertions.back());
 	else
-		m_assertions.emplace_back(true);
+		m_assertions.push_back(std::make_shared<AssertionNode const>(AssertionNode{smtutil::Expression(true), nullptr, 1}));
 }
 
 void EncodingContext::popSolver()
@@ -208,7 +224,10 @@ void EncodingContext::popSolver()
 void EncodingContext::addAssertion(smtutil::Expression const& _expr)
 {
 	if (m_assertions.empty())
-		m_assertions.push_back(_expr);
+		m_assertions.push_back(std::make_shared<AssertionNode const>(AssertionNode{_expr, nullptr, 1}));
 	else
-		m_assertions.back() = _expr && std::move(m_assertions.back());
+	{
+		size_t depth = m_assertions.back()->depth + 1;
+		m_assertions.back() = std::make_shared<AssertionNode const>(AssertionNode{_expr, std::move(m_assertions.back()), depth});
+	}
 }
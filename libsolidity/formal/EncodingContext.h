@@ -24,6 +24,7 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <memory>
 
 namespace solidity::frontend::smt
 {
@@ -137,8 +138,24 @@ public:
 
 	/// Solver.
 	//@{
+	/// An assertion together with the assertions added before it, as a persistent list.
+	/// Lists of different scopes share their common assertions, so they can be compared
+	/// cheaply, e.g. to add only the assertions that differ to an incremental solver.
+	struct AssertionNode
+	{
+		smtutil::Expression assertion;
+		std::shared_ptr<AssertionNode const> previous;
+		/// Number of assertions in the list ending with this node.
+		size_t depth;
+	};
+	using Assertions = std::shared_ptr<AssertionNode const>;
+
 	/// @returns conjunction of all added assertions.
 	smtutil::Expression assertions();
+	/// @returns the list of all added assertions, which is nullptr if there are none.
+	Assertions assertionList() const { return m_assertions.empty() ? nullptr : m_assertions.back(); }
+	/// @returns the conjunction of @a _assertions, the most recently added one first.
+	static smtutil::Expression conjunction(Assertions const& _assertions);
 	void pushSolver();
 	void popSolver();
 	void addAssertion(smtutil::Expression const& _e);
@@ -175,7 +192,7 @@ private:
 	smtutil::SolverInterface* m_solver = nullptr;
 
 	/// Assertion stack.
-	std::vector<smtutil::Expression> m_assertions;
+	std::vector<Assertions> m_assertions;
 
 	/// Whether to conjoin assertions in the assertion stack.
 	bool m_accumulateAssertions = true;
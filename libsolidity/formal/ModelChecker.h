@@ -27,6 +27,7 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -49,12 +50,15 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _queryCache if set, the results of the solver queries are looked up in
+	/// and added to this cache.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		std::shared_ptr<SMTQueryCache> _queryCache = nullptr
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -159,6 +159,9 @@ struct ModelCheckerSettings
 {
 	std::optional<unsigned> bmcLoopIterations;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
+	/// If more than one SMT solver is enabled, BMC queries them concurrently and uses the first answer.
+	/// This option queries them one after another instead and reports when they disagree.
+	bool detectSolverConflicts = false;
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
 	/// where k and m are slack variables.
@@ -169,6 +172,8 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// Number of threads BMC uses to check the verification targets of a function.
+	unsigned jobs = 1;
 	bool printQuery = false;
 	bool showProvedSafe = false;
 	bool showUnproved = false;
@@ -183,10 +188,12 @@ struct ModelCheckerSettings
 		return
 			bmcLoopIterations == _other.bmcLoopIterations &&
 			contracts == _other.contracts &&
+			detectSolverConflicts == _other.detectSolverConflicts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
+			jobs == _other.jobs &&
 			printQuery == _other.printQuery &&
 			showProvedSafe == _other.showProvedSafe &&
 			showUnproved == _other.showUnproved &&
@@ -0,0 +1,399 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#ifdef HAVE_Z3
+#include <libsmtutil/Z3Interface.h>
+#endif
+
+#include <libsolutil/Keccak256.h>
+
+#include <map>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::smtutil;
+using namespace solidity::util;
+
+namespace
+{
+
+std::map<CheckResult, std::string> const resultNames{
+	{CheckResult::SATISFIABLE, "sat"},
+	{CheckResult::UNSATISFIABLE, "unsat"},
+	{CheckResult::UNKNOWN, "unknown"}
+};
+
+CheckResult resultFromJson(Json const& _json)
+{
+	std::string const name = _json.get<std::string>();
+	for (auto const& [result, resultName]: resultNames)
+		if (resultName == name)
+			return result;
+	throw Json::other_error::create(501, "Invalid query result: " + name, &_json);
+}
+
+}
+
+SMTQueryCache::SMTQueryCache(boost::filesystem::path _directory, size_t _maxEntries):
+	m_storage(std::move(_directory), _maxEntries)
+{
+}
+
+std::string SMTQueryCache::solverContext(SMTSolverChoice _solvers, std::optional<unsigned> _timeout)
+{
+	std::string context = "solc " + VersionString + "\n";
+	if (_solvers.cvc4)
+		context += "cvc4\n";
+	if (_solvers.eld)
+		context += "eld\n";
+	if (_solvers.smtlib2)
+		context += "smtlib2\n";
+	if (_solvers.z3)
+	{
+		context += "z3";
+#ifdef HAVE_Z3
+		context += " " + smtutil::Z3Interface::version();
+#endif
+		context += "\n";
+	}
+	if (_timeout)
+		context += "timeout " + std::to_string(*_timeout) + "\n";
+	return context;
+}
+
+h256 SMTQueryCache::key(std::string const& _context, std::string const& _query)
+{
+	return keccak256(_context + '\0' + _query);
+}
+
+bool SMTQueryCache::cacheable(CheckResult _result, bool _deterministic)
+{
+	return
+		_result == CheckResult::SATISFIABLE ||
+		_result == CheckResult::UNSATISFIABLE ||
+		(_result == CheckResult::UNKNOWN && _deterministic);
+}
+
+std::optional<SMTQueryCache::SMTResult> SMTQueryCache::loadSMT(h256 const& _key)
+{
+	std::optional<Json> entry = m_storage.load(_key);
+	if (!entry)
+		return std::nullopt;
+
+	try
+	{
+		return SMTResult{
+			resultFromJson(entry->at("result")),
+			entry->at("values").get<std::vector<std::string>>()
+		};
+	}
+	catch (Json::exception const&)
+	{
+		m_storage.invalidate(_key);
+		return std::nullopt;
+	}
+}
+
+void SMTQueryCache::storeSMT(h256 const& _key, SMTResult const& _result)
+{
+	m_storage.store(_key, Json{
+		{"result", resultNames.at(_result.first)},
+		{"values", _result.second}
+	});
+}
+
+std::optional<SMTQueryCache::CHCResult> SMTQueryCache::loadCHC(h256 const& _key)
+{
+	std::optional<Json> entry = m_storage.load(_key);
+	if (!entry)
+		return std::nullopt;
+
+	try
+	{
+		CHCSolverInterface::CexGraph cex;
+		for (Json const& node: entry->at("cex").at("nodes"))
+			cex.nodes.emplace(node.at(0).get<unsigned>(), expressionFromJson(node.at(1)));
+		for (Json const& edges: entry->at("cex").at("edges"))
+			cex.edges.emplace(edges.at(0).get<unsigned>(), edges.at(1).get<std::vector<unsigned>>());
+		return CHCResult{
+			resultFromJson(entry->at("result")),
+			expressionFromJson(entry->at("invariant")),
+			std::move(cex)
+		};
+	}
+	catch (Json::exception const&)
+	{
+		m_storage.invalidate(_key);
+		return std::nullopt;
+	}
+}
+
+void SMTQueryCache::storeCHC(h256 const& _key, CHCResult const& _result)
+{
+	auto const& [result, invariant, cex] = _result;
+	Json nodes = Json::array();
+	for (auto const& [id, node]: cex.nodes)
+		nodes.emplace_back(Json::array({id, expressionToJson(node)}));
+	Json edges = Json::array();
+	for (auto const& [id, targets]: cex.edges)
+		edges.emplace_back(Json::array({id, targets}));
+
+	m_storage.store(_key, Json{
+		{"result", resultNames.at(result)},
+		{"invariant", expressionToJson(invariant)},
+		{"cex", {{"nodes", std::move(nodes)}, {"edges", std::move(edges)}}}
+	});
+}
+
+Json SMTQueryCache::sortToJson(Sort const& _sort)
+{
+	auto sortsToJson = [](std::vector<SortPointer> const& _sorts) {
+		Json json = Json::array();
+		for (SortPointer const& sort: _sorts)
+			json.emplace_back(sortToJson(*sort));
+		return json;
+	};
+
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		return {{"kind", "int"}, {"signed", dynamic_cast<IntSort const&>(_sort).isSigned}};
+	case Kind::Bool:
+		return {{"kind", "bool"}};
+	case Kind::BitVector:
+		return {{"kind", "bitvector"}, {"size", dynamic_cast<BitVectorSort const&>(_sort).size}};
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		return {
+			{"kind", "function"},
+			{"domain", sortsToJson(functionSort.domain)},
+			{"codomain", sortToJson(*functionSort.codomain)}
+		};
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		return {{"kind", "array"}, {"domain", sortToJson(*arraySort.domain)}, {"range", sortToJson(*arraySort.range)}};
+	}
+	case Kind::Sort:
+		return {{"kind", "sort"}, {"inner", sortToJson(*dynamic_cast<SortSort const&>(_sort).inner)}};
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		return {
+			{"kind", "tuple"},
+			{"name", tupleSort.name},
+			{"members", tupleSort.members},
+			{"components", sortsToJson(tupleSort.components)}
+		};
+	}
+	}
+	smtAssert(false);
+}
+
+SortPointer SMTQueryCache::sortFromJson(Json const& _json)
+{
+	auto sortsFromJson = [](Json const& _sorts) {
+		std::vector<SortPointer> sorts;
+		for (Json const& sort: _sorts)
+			sorts.emplace_back(sortFromJson(sort));
+		return sorts;
+	};
+
+	std::string const kind = _json.at("kind").get<std::string>();
+	if (kind == "int")
+		return SortProvider::intSort(_json.at("signed").get<bool>());
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bitvector")
+		return std::make_shared<BitVectorSort>(_json.at("size").get<unsigned>());
+	else if (kind == "function")
+		return std::make_shared<FunctionSort>(sortsFromJson(_json.at("domain")), sortFromJson(_json.at("codomain")));
+	else if (kind == "array")
+		return std::make_shared<ArraySort>(sortFromJson(_json.at("domain")), sortFromJson(_json.at("range")));
+	else if (kind == "sort")
+		return std::make_shared<SortSort>(sortFromJson(_json.at("inner")));
+	else if (kind == "tuple")
+		return std::make_shared<TupleSort>(
+			_json.at("name").get<std::string>(),
+			_json.at("members").get<std::vector<std::string>>(),
+			sortsFromJson(_json.at("components"))
+		);
+	throw Json::other_error::create(501, "Invalid sort kind: " + kind, &_json);
+}
+
+Json SMTQueryCache::expressionToJson(Expression const& _expression)
+{
+	Json json{{"name", _expression.name}, {"sort", sortToJson(*_expression.sort)}};
+	if (!_expression.arguments.empty())
+	{
+		json["arguments"] = Json::array();
+		for (Expression const& argument: _expression.arguments)
+			json["arguments"].emplace_back(expressionToJson(argument));
+	}
+	return json;
+}
+
+Expression SMTQueryCache::expressionFromJson(Json const& _json)
+{
+	std::vector<Expression> arguments;
+	if (_json.contains("arguments"))
+		for (Json const& argument: _json.at("arguments"))
+			arguments.emplace_back(expressionFromJson(argument));
+	return Expression(_json.at("name").get<std::string>(), std::move(arguments), sortFromJson(_json.at("sort")));
+}
+
+CanonicalQuery::CanonicalQuery(std::function<bool(Expression const&)> _isSymbol):
+	m_isSymbol(std::move(_isSymbol))
+{
+}
+
+void CanonicalQuery::add(std::string const& _kind, Expression const& _expression)
+{
+	m_text += _kind + ' ';
+	print(_expression);
+	m_text += '\n';
+}
+
+SMTQueryCache::CHCResult CanonicalQuery::canonical(SMTQueryCache::CHCResult const& _result)
+{
+	auto const& [result, invariant, cex] = _result;
+	CHCSolverInterface::CexGraph canonicalCex{{}, cex.edges};
+	for (auto const& [id, node]: cex.nodes)
+		canonicalCex.nodes.emplace(id, canonical(node));
+	return {result, canonical(invariant), std::move(canonicalCex)};
+}
+
+SMTQueryCache::CHCResult CanonicalQuery::original(SMTQueryCache::CHCResult const& _result) const
+{
+	auto const& [result, invariant, cex] = _result;
+	CHCSolverInterface::CexGraph originalCex{{}, cex.edges};
+	for (auto const& [id, node]: cex.nodes)
+		originalCex.nodes.emplace(id, original(node));
+	return {result, original(invariant), std::move(originalCex)};
+}
+
+void CanonicalQuery::print(Expression const& _expression)
+{
+	// The sort of every subexpression is part of the text, since the names of some
+	// operators, e.g. bv2int, do not determine their sort.
+	if (!_expression.arguments.empty())
+		m_text += '(';
+	m_text += '|';
+	m_text += m_isSymbol(_expression) ? canonicalName(_expression.name) : _expression.name;
+	m_text += "|:";
+	m_text += sortText(*_expression.sort);
+	for (Expression const& argument: _expression.arguments)
+	{
+		m_text += ' ';
+		print(argument);
+	}
+	if (!_expression.arguments.empty())
+		m_text += ')';
+}
+
+std::string const& CanonicalQuery::sortText(Sort const& _sort)
+{
+	if (auto text = m_sortTexts.find(&_sort); text != m_sortTexts.end())
+		return text->second;
+
+	std::string text;
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		text = dynamic_cast<IntSort const&>(_sort).isSigned ? "int" : "uint";
+		break;
+	case Kind::Bool:
+		text = "bool";
+		break;
+	case Kind::BitVector:
+		text = "bv" + std::to_string(dynamic_cast<BitVectorSort const&>(_sort).size);
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		text = "(function";
+		for (SortPointer const& sort: functionSort.domain)
+			text += ' ' + sortText(*sort);
+		text += ' ' + sortText(*functionSort.codomain) + ')';
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		text = "(array " + sortText(*arraySort.domain) + ' ' + sortText(*arraySort.range) + ')';
+		break;
+	}
+	case Kind::Sort:
+		text = "(sort " + sortText(*dynamic_cast<SortSort const&>(_sort).inner) + ')';
+		break;
+	case Kind::Tuple:
+	{
+		// Tuple names are derived from Solidity types without AST IDs, so they are kept.
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		text = "(tuple |" + tupleSort.name + '|';
+		for (SortPointer const& sort: tupleSort.components)
+			text += ' ' + sortText(*sort);
+		text += ')';
+		break;
+	}
+	}
+	return m_sortTexts[&_sort] = std::move(text);
+}
+
+std::string const& CanonicalQuery::canonicalName(std::string const& _name)
+{
+	auto [name, inserted] = m_canonicalNames.emplace(_name, "");
+	if (inserted)
+	{
+		// Declared names never contain '@'.
+		name->second = "@" + std::to_string(m_originalNames.size());
+		m_originalNames.emplace(name->second, _name);
+	}
+	return name->second;
+}
+
+Expression CanonicalQuery::canonical(Expression const& _expression)
+{
+	std::vector<Expression> arguments;
+	for (Expression const& argument: _expression.arguments)
+		arguments.emplace_back(canonical(argument));
+	return Expression(
+		m_isSymbol(_expression) ? canonicalName(_expression.name) : _expression.name,
+		std::move(arguments),
+		_expression.sort
+	);
+}
+
+Expression CanonicalQuery::original(Expression const& _expression) const
+{
+	std::vector<Expression> arguments;
+	for (Expression const& argument: _expression.arguments)
+		arguments.emplace_back(original(argument));
+	auto name = m_originalNames.find(_expression.name);
+	return Expression(
+		name != m_originalNames.end() ? name->second : _expression.name,
+		std::move(arguments),
+		_expression.sort
+	);
+}
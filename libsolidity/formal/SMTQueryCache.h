@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of the results of SMT and Horn queries.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Directory of query results, one JSON file per query, shared by the model checking
+ * engines of all compiler runs that use the same directory.
+ *
+ * The key of a query is computed from its CanonicalQuery text and a context
+ * string that has to identify everything else the result depends on, e.g. the engine,
+ * the solvers and their settings. Only results that do not depend on the time the
+ * solver took are stored.
+ *
+ * As with the CompilationCache, problems accessing the directory are treated like misses
+ * and only files named like entries are ever removed from it.
+ */
+class SMTQueryCache
+{
+public:
+	using SMTResult = std::pair<smtutil::CheckResult, std::vector<std::string>>;
+	using CHCResult = std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph>;
+
+	/// Opens the cache in @a _directory, creating the directory if it does not exist.
+	/// @param _maxEntries maximum number of query results kept in the directory, see CompilationCache.
+	/// @throws boost::filesystem::filesystem_error if the directory cannot be created.
+	explicit SMTQueryCache(boost::filesystem::path _directory, size_t _maxEntries = 0);
+
+	/// @returns a description of the compiler and of the enabled solvers with their versions and
+	/// settings, to be used as part of the context of the keys of queries answered by them.
+	static std::string solverContext(smtutil::SMTSolverChoice _solvers, std::optional<unsigned> _timeout);
+	static util::h256 key(std::string const& _context, std::string const& _query);
+
+	/// @returns true if a query with result @a _result can be stored.
+	/// @param _deterministic whether UNKNOWN means that the solver gave up on the query
+	///     within a deterministic resource limit rather than a timeout or a missing answer.
+	static bool cacheable(smtutil::CheckResult _result, bool _deterministic);
+
+	std::optional<SMTResult> loadSMT(util::h256 const& _key);
+	void storeSMT(util::h256 const& _key, SMTResult const& _result);
+
+	std::optional<CHCResult> loadCHC(util::h256 const& _key);
+	void storeCHC(util::h256 const& _key, CHCResult const& _result);
+
+	CompilationCache::Statistics const& statistics() const { return m_storage.statistics(); }
+
+	static Json sortToJson(smtutil::Sort const& _sort);
+	/// @throws Json::exception if @a _json is not in the format produced by @a sortToJson.
+	static smtutil::SortPointer sortFromJson(Json const& _json);
+	static Json expressionToJson(smtutil::Expression const& _expression);
+	/// @throws Json::exception if @a _json is not in the format produced by @a expressionToJson.
+	static smtutil::Expression expressionFromJson(Json const& _json);
+
+private:
+	CompilationCache m_storage;
+};
+
+/**
+ * Text of a query from which its key in the SMTQueryCache is computed.
+ *
+ * The names of the symbols declared by the encoding contain AST IDs, which change for every
+ * node after an edit, also in later source units. They are therefore renamed in the order in
+ * which they are first used in the text, which does not change the result of the query since
+ * these symbols are uninterpreted. Results taken from the cache are renamed back.
+ */
+class CanonicalQuery
+{
+public:
+	/// @param _isSymbol returns whether the name of an expression is declared by the encoding
+	/// rather than interpreted by the solvers. Only these names are renamed.
+	explicit CanonicalQuery(std::function<bool(smtutil::Expression const&)> _isSymbol);
+
+	/// Appends @a _expression to the text, preceded by @a _kind, which describes its role in the query.
+	void add(std::string const& _kind, smtutil::Expression const& _expression);
+	std::string const& text() const { return m_text; }
+
+	/// @returns @a _result with the symbols renamed as in the text, to be stored in the cache.
+	/// Symbols that are not used in the text get new names, so that a result loaded for another
+	/// query with the same text never refers to symbols of that query by their original names.
+	SMTQueryCache::CHCResult canonical(SMTQueryCache::CHCResult const& _result);
+	/// @returns @a _result loaded from the cache with the names of the symbols of this query.
+	SMTQueryCache::CHCResult original(SMTQueryCache::CHCResult const& _result) const;
+
+private:
+	void print(smtutil::Expression const& _expression);
+	std::string const& sortText(smtutil::Sort const& _sort);
+	std::string const& canonicalName(std::string const& _name);
+	smtutil::Expression canonical(smtutil::Expression const& _expression);
+	smtutil::Expression original(smtutil::Expression const& _expression) const;
+
+	std::function<bool(smtutil::Expression const&)> m_isSymbol;
+	std::map<std::string, std::string> m_canonicalNames;
+	std::map<std::string, std::string> m_originalNames;
+	std::map<smtutil::Sort const*, std::string> m_sortTexts;
+	std::string m_text;
+};
+
+}
@@ -0,0 +1,257 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Numeric.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+CompilationCache::CompilationCache(fs::path _directory, size_t _maxEntries):
+	m_directory(std::move(_directory)),
+	m_maxEntries(_maxEntries)
+{
+	fs::create_directories(m_directory);
+
+	if (m_maxEntries == 0)
+		return;
+	try
+	{
+		std::vector<std::pair<std::time_t, std::string>> entries;
+		for (fs::directory_entry const& file: fs::directory_iterator(m_directory))
+			if (fs::is_regular_file(file.status()) && isEntryName(file.path().filename()))
+				entries.emplace_back(fs::last_write_time(file.path()), file.path().filename().string());
+		std::sort(entries.begin(), entries.end());
+		for (auto const& [time, name]: entries)
+			markUsed(name);
+	}
+	catch (fs::filesystem_error const&)
+	{
+		// Entries that could not be listed are never evicted by this cache.
+	}
+}
+
+std::optional<Json> CompilationCache::load(h256 const& _key)
+{
+	fs::path const path = entryPath(_key);
+	try
+	{
+		if (!fs::exists(path))
+		{
+			forget(path.filename().string());
+			++m_statistics.misses;
+			return std::nullopt;
+		}
+
+		Json entry;
+		if (!jsonParseStrict(readFileAsString(path), entry) || !entry.is_object())
+		{
+			forget(path.filename().string());
+			fs::remove(path);
+			++m_statistics.evictions;
+			++m_statistics.misses;
+			return std::nullopt;
+		}
+
+		// The modification time is used to determine the least recently used entries
+		// when the cache is opened again.
+		fs::last_write_time(path, std::time(nullptr));
+		if (m_maxEntries > 0)
+			markUsed(path.filename().string());
+		++m_statistics.hits;
+		m_loadedKeys.insert(_key);
+		return entry;
+	}
+	catch (fs::filesystem_error const&)
+	{
+		++m_statistics.misses;
+		return std::nullopt;
+	}
+}
+
+void CompilationCache::store(h256 const& _key, Json const& _entry)
+{
+	try
+	{
+		// Write to a temporary file first so that concurrent compiler processes
+		// never observe a partially written entry.
+		fs::path const temporaryPath = fs::unique_path(m_directory / "%%%%-%%%%-%%%%-%%%%.tmp");
+		{
+			fs::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			file << jsonCompactPrint(_entry);
+			if (!file)
+			{
+				file.close();
+				fs::remove(temporaryPath);
+				return;
+			}
+		}
+		fs::rename(temporaryPath, entryPath(_key));
+
+		if (m_maxEntries > 0)
+		{
+			markUsed(entryPath(_key).filename().string());
+			evictEntries();
+		}
+	}
+	catch (fs::filesystem_error const&)
+	{
+	}
+}
+
+void CompilationCache::invalidate(h256 const& _key)
+{
+	forget(entryPath(_key).filename().string());
+	try
+	{
+		if (fs::remove(entryPath(_key)))
+			++m_statistics.evictions;
+	}
+	catch (fs::filesystem_error const&)
+	{
+	}
+
+	if (m_loadedKeys.erase(_key))
+	{
+		--m_statistics.hits;
+		++m_statistics.misses;
+	}
+}
+
+Json CompilationCache::linkerObjectToJson(LinkerObject const& _object)
+{
+	Json json = Json::object();
+	json["bytecode"] = util::toHex(_object.bytecode);
+
+	json["linkReferences"] = Json::array();
+	for (auto const& [offset, libraryName]: _object.linkReferences)
+		json["linkReferences"].emplace_back(Json::array({offset, libraryName}));
+
+	json["immutableReferences"] = Json::object();
+	for (auto const& [hash, immutable]: _object.immutableReferences)
+	{
+		auto const& [name, offsets] = immutable;
+		json["immutableReferences"][toCompactHexWithPrefix(hash)] = Json{{"name", name}, {"offsets", offsets}};
+	}
+
+	json["functionDebugData"] = Json::object();
+	for (auto const& [name, debugData]: _object.functionDebugData)
+	{
+		Json& functionJson = json["functionDebugData"][name] = Json::object();
+		if (debugData.bytecodeOffset)
+			functionJson["bytecodeOffset"] = *debugData.bytecodeOffset;
+		if (debugData.instructionIndex)
+			functionJson["instructionIndex"] = *debugData.instructionIndex;
+		if (debugData.sourceID)
+			functionJson["sourceID"] = *debugData.sourceID;
+		functionJson["params"] = debugData.params;
+		functionJson["returns"] = debugData.returns;
+	}
+
+	return json;
+}
+
+LinkerObject CompilationCache::linkerObjectFromJson(Json const& _json)
+{
+	LinkerObject object;
+	object.bytecode = fromHex(_json.at("bytecode").get<std::string>());
+
+	for (Json const& reference: _json.at("linkReferences"))
+		object.linkReferences[reference.at(0).get<size_t>()] = reference.at(1).get<std::string>();
+
+	for (auto const& [hash, immutable]: _json.at("immutableReferences").items())
+		object.immutableReferences[u256(hash)] = {
+			immutable.at("name").get<std::string>(),
+			immutable.at("offsets").get<std::vector<size_t>>()
+		};
+
+	for (auto const& [name, functionJson]: _json.at("functionDebugData").items())
+	{
+		LinkerObject::FunctionDebugData& debugData = object.functionDebugData[name];
+		if (functionJson.contains("bytecodeOffset"))
+			debugData.bytecodeOffset = functionJson["bytecodeOffset"].get<size_t>();
+		if (functionJson.contains("instructionIndex"))
+			debugData.instructionIndex = functionJson["instructionIndex"].get<size_t>();
+		if (functionJson.contains("sourceID"))
+			debugData.sourceID = functionJson["sourceID"].get<size_t>();
+		debugData.params = functionJson.at("params").get<size_t>();
+		debugData.returns = functionJson.at("returns").get<size_t>();
+	}
+
+	return object;
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
+
+bool CompilationCache::isEntryName(fs::path const& _fileName)
+{
+	// Only files named like the entries written by @a store are ever touched, so that
+	// pointing the cache at a directory that holds other files cannot remove them.
+	std::string const name = _fileName.string();
+	return
+		name.size() == 2 * size_t(h256::size) + 5 &&
+		boost::ends_with(name, ".json") &&
+		std::all_of(name.begin(), name.end() - 5, [](char _c) {
+			return ('0' <= _c && _c <= '9') || ('a' <= _c && _c <= 'f');
+		});
+}
+
+void CompilationCache::markUsed(std::string const& _name)
+{
+	forget(_name);
+	m_entryPositions[_name] = m_entriesByUse.insert(m_entriesByUse.end(), _name);
+}
+
+void CompilationCache::forget(std::string const& _name)
+{
+	if (auto position = m_entryPositions.find(_name); position != m_entryPositions.end())
+	{
+		m_entriesByUse.erase(position->second);
+		m_entryPositions.erase(position);
+	}
+}
+
+void CompilationCache::evictEntries()
+{
+	while (m_entriesByUse.size() > m_maxEntries)
+	{
+		std::string const name = m_entriesByUse.front();
+		forget(name);
+		// Entries removed by other processes in the meantime are not counted.
+		if (fs::remove(m_directory / name))
+			++m_statistics.evictions;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent, content-addressed cache of compilation artifacts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Directory of compilation artifacts, one JSON file per contract, named after a key
+ * that identifies the sources and settings the artifacts were produced from.
+ *
+ * Any problem accessing the directory after construction is treated like a cache miss,
+ * so that the cache can never cause a compilation to fail.
+ */
+class CompilationCache
+{
+public:
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+	};
+
+	/// Opens the cache in @a _directory, creating the directory if it does not exist.
+	/// @param _maxEntries maximum number of entries kept in the directory. If exceeded, the least
+	///     recently used entries are evicted. Zero means no limit. The existing entries are
+	///     listed once, here, and tracked in memory afterwards.
+	/// @throws boost::filesystem::filesystem_error if the directory cannot be created.
+	explicit CompilationCache(boost::filesystem::path _directory, size_t _maxEntries = 0);
+
+	/// @returns the entry stored under @a _key or nullopt if there is none.
+	std::optional<Json> load(util::h256 const& _key);
+	/// Stores @a _entry under @a _key, replacing any existing entry.
+	void store(util::h256 const& _key, Json const& _entry);
+	/// Removes the entry stored under @a _key, e.g. because it could not be interpreted.
+	/// If the entry has been returned by @a load, that hit is counted as a miss instead.
+	void invalidate(util::h256 const& _key);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+	Statistics const& statistics() const { return m_statistics; }
+
+	static Json linkerObjectToJson(evmasm::LinkerObject const& _object);
+	/// @throws Json::exception if @a _json is not in the format produced by @a linkerObjectToJson.
+	static evmasm::LinkerObject linkerObjectFromJson(Json const& _json);
+
+	/// @returns true if @a _fileName has the format of the names of the files holding entries,
+	/// i.e. the key in lowercase hex followed by ".json".
+	static bool isEntryName(boost::filesystem::path const& _fileName);
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Moves the entry in file @a _name to the end of @a m_entriesByUse.
+	void markUsed(std::string const& _name);
+	/// Removes the entry in file @a _name from @a m_entriesByUse.
+	void forget(std::string const& _name);
+	/// Removes the least recently used entries until at most @a m_maxEntries remain.
+	void evictEntries();
+
+	boost::filesystem::path m_directory;
+	size_t m_maxEntries = 0;
+	Statistics m_statistics;
+	/// File names of the entries, from the least to the most recently used. Only kept if the number
+	/// of entries is limited. It is read from the directory once, when the cache is opened, so
+	/// entries written by other processes later on are not evicted by this one.
+	std::list<std::string> m_entriesByUse;
+	std::map<std::string, std::list<std::string>::iterator> m_entryPositions;
+	/// Keys of the entries returned by @a load.
+	std::set<util::h256> m_loadedKeys;
+};
+
+}
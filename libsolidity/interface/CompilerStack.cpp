@@ -50,6 +50,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -73,6 +74,7 @@
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 #include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -84,6 +86,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -229,6 +232,27 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setJobs(size_t _jobs)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the number of jobs before compilation.");
+	m_jobs = std::max<size_t>(_jobs, 1);
+}
+
+void CompilerStack::setCompilationCache(std::shared_ptr<CompilationCache> _cache)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the compilation cache before compilation.");
+	m_compilationCache = std::move(_cache);
+}
+
+void CompilerStack::setRequestedArtifacts(std::set<Artifact> _artifacts)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the requested artifacts before compilation.");
+	m_requestedArtifacts = std::move(_artifacts);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -255,6 +279,13 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 	m_modelCheckerSettings = _settings;
 }
 
+void CompilerStack::setSMTQueryCache(std::shared_ptr<SMTQueryCache> _cache)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set the SMT query cache before parsing.");
+	m_smtQueryCache = std::move(_cache);
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -324,9 +355,13 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_jobs = 1;
+		m_compilationCache.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
+		m_smtQueryCache.reset();
 		m_generateIR = false;
+		m_profileOptimizer = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -362,54 +397,93 @@ bool CompilerStack::parse()
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion};
-
 	std::vector<std::string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Sources are parsed in waves: first the ones that were set, then the ones imported by the
+	// previous wave. The sources of a wave are parsed concurrently, each by its own parser, and
+	// the results are merged in the order of sourcesToParse. AST IDs, errors and newly discovered
+	// imports are therefore the same as if a single parser had parsed them one after another.
+	struct ParsedSource
 	{
-		std::string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
-		{
-			source.ast->annotation().path = path;
+		ErrorList errors;
+		std::unique_ptr<ErrorReporter> errorReporter;
+		std::unique_ptr<Parser> parser;
+		ASTPointer<SourceUnit> ast;
+	};
+	int64_t maxAstId = 0;
+	for (size_t waveStart = 0; waveStart < sourcesToParse.size();)
+	{
+		size_t const waveEnd = sourcesToParse.size();
+		std::vector<ParsedSource> parsedSources(waveEnd - waveStart);
+		util::parallelFor(parsedSources.size(), m_jobs, [&](size_t _index) {
+			std::string const& path = sourcesToParse[waveStart + _index];
+			ParsedSource& parsed = parsedSources[_index];
+			parsed.errorReporter = std::make_unique<ErrorReporter>(parsed.errors);
+			parsed.parser = std::make_unique<Parser>(*parsed.errorReporter, m_evmVersion);
+			CharStream& charStream = *m_sources.at(path).charStream;
+			// The scanner advances the char stream, so a source listed twice is parsed from a copy.
+			auto const waveBegin = sourcesToParse.begin() + static_cast<std::ptrdiff_t>(waveStart);
+			auto const current = waveBegin + static_cast<std::ptrdiff_t>(_index);
+			if (std::find(waveBegin, current, path) != current)
+			{
+				CharStream copy(charStream.source(), charStream.name());
+				parsed.ast = parsed.parser->parse(copy);
+			}
+			else
+				parsed.ast = parsed.parser->parse(charStream);
+		});
 
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+		for (size_t index = waveStart; index < waveEnd; ++index)
+		{
+			std::string const path = sourcesToParse[index];
+			ParsedSource& parsed = parsedSources[index - waveStart];
+			m_errorReporter.append(parsed.errors);
+			parsed.parser->shiftIDs(maxAstId);
+			maxAstId = parsed.parser->maxID();
+
+			Source& source = m_sources[path];
+			source.ast = parsed.ast;
+			if (!source.ast)
+				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
 			{
-				solAssert(!import->path().empty(), "Import path cannot be empty.");
-				// Check whether the import directive is for the standard library,
-				// and if yes, add specified file to source units to be parsed.
-				auto it = stdlib::sources.find(import->path());
-				if (it != stdlib::sources.end())
+				source.ast->annotation().path = path;
+
+				for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
 				{
-					auto [name, content] = *it;
-					m_sources[name].charStream = std::make_unique<CharStream>(content, name);
-					sourcesToParse.push_back(name);
+					solAssert(!import->path().empty(), "Import path cannot be empty.");
+					// Check whether the import directive is for the standard library,
+					// and if yes, add specified file to source units to be parsed.
+					auto it = stdlib::sources.find(import->path());
+					if (it != stdlib::sources.end())
+					{
+						auto [name, content] = *it;
+						m_sources[name].charStream = std::make_unique<CharStream>(content, name);
+						sourcesToParse.push_back(name);
+					}
+
+					// The current value of `path` is the absolute path as seen from this source file.
+					// We first have to apply remappings before we can store the actual absolute path
+					// as seen globally.
+					import->annotation().absolutePath = applyRemapping(util::absolutePath(
+						import->path(),
+						path
+					), path);
 				}
 
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				import->annotation().absolutePath = applyRemapping(util::absolutePath(
-					import->path(),
-					path
-				), path);
+				if (m_stopAfter >= ParsedAndImported)
+					for (auto const& newSource: loadMissingSources(*source.ast))
+					{
+						std::string const& newPath = newSource.first;
+						std::string const& newContents = newSource.second;
+						m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
+						sourcesToParse.push_back(newPath);
+					}
 			}
-
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
-				{
-					std::string const& newPath = newSource.first;
-					std::string const& newContents = newSource.second;
-					m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
-				}
 		}
+		waveStart = waveEnd;
 	}
 
 	if (Error::containsErrors(m_errorReporter.errors()))
@@ -419,7 +493,7 @@ bool CompilerStack::parse()
 	storeContractDefinitions();
 
 	solAssert(!m_maxAstId.has_value());
-	m_maxAstId = parser.maxID();
+	m_maxAstId = maxAstId;
 
 	return true;
 }
@@ -660,7 +734,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 					universalCallback->smtCommand().setEldarica(m_modelCheckerSettings.timeout, m_modelCheckerSettings.invariants != ModelCheckerInvariants::None());
 		}
 
-		ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+		ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_smtQueryCache);
 		modelChecker.checkRequestedSourcesAndContracts(allSources);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
@@ -733,19 +807,67 @@ bool CompilerStack::compile(State _stopAfter)
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
 
+	// With multiple jobs, the IR of all contracts is generated first and then optimized
+	// and compiled to EVM code concurrently.
+	bool const optimizeIRInParallel = m_jobs > 1 && ((m_generateEvmBytecode && m_viaIR) || m_generateIR);
+
+	// Contracts served from the compilation cache are not compiled, unless a contract that
+	// is compiled depends on them.
+	auto const isCacheable = [&](ContractDefinition const& _contract) {
+		if (
+			!m_compilationCache ||
+			!(m_generateEvmBytecode || m_generateIR) ||
+			// The optimizer has to run to be profiled.
+			m_profileOptimizer ||
+			m_compilationSourceType != CompilationSourceType::Solidity ||
+			m_experimentalAnalysis ||
+			!_contract.canBeDeployed() ||
+			!isRequestedContract(_contract)
+		)
+			return false;
+		// The warning about ABI coder v1 being incompatible with the IR would be lost on a cache hit.
+		if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
+		{
+			if (!*_contract.sourceUnit().annotation().useABICoderV2)
+				return false;
+			for (SourceUnit const* sourceUnit: _contract.sourceUnit().referencedSourceUnits(true))
+				if (!*sourceUnit->annotation().useABICoderV2)
+					return false;
+		}
+		return true;
+	};
+	std::set<ContractDefinition const*> cachedContracts;
 	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					try
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+			if (isCacheable(*contract) && loadFromCompilationCache(*contract))
+				cachedContracts.insert(contract);
+
+	try
+	{
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
 					{
+						if (cachedContracts.count(contract))
+						{
+							// In the parallel case, the limits are checked after assembling all contracts.
+							if (m_generateEvmBytecode && !(m_viaIR && optimizeIRInParallel))
+								checkCodeSizeLimits(*contract);
+							continue;
+						}
 						if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
-							generateIR(*contract);
+							generateIR(*contract, !optimizeIRInParallel);
 						if (m_generateEvmBytecode)
 						{
 							if (m_viaIR)
-								generateEVMFromIR(*contract);
+							{
+								if (!optimizeIRInParallel)
+								{
+									generateEVMFromIR(*contract);
+									checkCodeSizeLimits(*contract);
+								}
+							}
 							else
 							{
 								if (m_experimentalAnalysis)
@@ -754,38 +876,45 @@ bool CompilerStack::compile(State _stopAfter)
 							}
 						}
 					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							std::string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								fmt::format(
-									"Unimplemented feature error {} in {}",
-									(comment && !comment->empty()) ? ": " + *comment : "",
-									_unimplementedError.lineInfo()
-								)
-							);
-							return false;
-						}
-						else
-							throw;
-					}
-				}
+
+		if (optimizeIRInParallel)
+			optimizeIRAndGenerateEVMInParallel();
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			std::string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				fmt::format(
+					"Unimplemented feature error {} in {}",
+					(comment && !comment->empty()) ? ": " + *comment : "",
+					_unimplementedError.lineInfo()
+				)
+			);
+			return false;
+		}
+		else
+			throw;
+	}
 	m_stackState = CompilationSuccessful;
+	for (Source const* source: m_sourceOrder)
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+			if (isCacheable(*contract) && !cachedContracts.count(contract))
+				storeInCompilationCache(*contract);
 	this->link();
 	return true;
 }
@@ -851,7 +980,21 @@ Json CompilerStack::generatedSources(std::string const& _contractName, bool _run
 		_runtime ?
 		c.runtimeGeneratedSources :
 		c.generatedSources;
-	return sources.init([&]{
+	return sources.init([&]{ return generatedSourcesUncached(_contractName, _runtime); });
+}
+
+Json CompilerStack::generatedSourcesUncached(std::string const& _contractName, bool _runtime) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& c = contract(_contractName);
+	util::LazyInit<Json const> const& sources =
+		_runtime ?
+		c.runtimeGeneratedSources :
+		c.generatedSources;
+	// Sources served from the compilation cache are stored in the contract.
+	return sources.valueOrCompute([&]{
 		Json sources = Json::array();
 		// If there is no compiler, then no bytecode was generated and thus no
 		// sources were generated (or we compiled "via IR").
@@ -952,7 +1095,32 @@ Json const& CompilerStack::yulIRAst(std::string const& _contractName) const
 
 	solUnimplementedAssert(!isExperimentalSolidity());
 
-	return contract(_contractName).yulIRAst;
+	return contract(_contractName).yulIRAst.init([&]{ return yulIRAstUncached(_contractName); });
+}
+
+Json CompilerStack::yulIRAstUncached(std::string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIRAst.valueOrCompute([&]{
+		if (compiledContract.yulIR.empty())
+			return Json{};
+		// The stack of the contract has been optimized in place, so the IR is parsed again.
+		yul::YulStack stack(
+			m_evmVersion,
+			m_eofVersion,
+			yul::YulStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+		solAssert(yulAnalysisSuccessful);
+		return stack.astJson();
+	});
 }
 
 std::string const& CompilerStack::yulIROptimized(std::string const& _contractName) const
@@ -960,7 +1128,20 @@ std::string const& CompilerStack::yulIROptimized(std::string const& _contractNam
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimized;
+	return contract(_contractName).yulIROptimized.init([&]{ return yulIROptimizedUncached(_contractName); });
+}
+
+std::string CompilerStack::yulIROptimizedUncached(std::string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.valueOrCompute([&]{
+		if (!compiledContract.yulStack)
+			return std::string{};
+		return compiledContract.yulStack->print(this);
+	});
 }
 
 Json const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
@@ -970,7 +1151,32 @@ Json const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) c
 
 	solUnimplementedAssert(!isExperimentalSolidity());
 
-	return contract(_contractName).yulIROptimizedAst;
+	return contract(_contractName).yulIROptimizedAst.init([&]{ return yulIROptimizedAstUncached(_contractName); });
+}
+
+Json CompilerStack::yulIROptimizedAstUncached(std::string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimizedAst.valueOrCompute([&]{
+		if (!compiledContract.yulStack)
+			return Json{};
+		return compiledContract.yulStack->astJson();
+	});
+}
+
+Json const& CompilerStack::optimizerProfile(std::string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	return contract(_contractName).optimizerProfile;
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -998,6 +1204,8 @@ std::string CompilerStack::assemblyString(std::string const& _contractName, Stri
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
+	else if (currentContract.cachedArtifacts.contains("assembly"))
+		return currentContract.cachedArtifacts["assembly"].get<std::string>();
 	else
 		return std::string();
 }
@@ -1013,6 +1221,8 @@ Json CompilerStack::assemblyJSON(std::string const& _contractName) const
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+	else if (currentContract.cachedArtifacts.contains("legacyAssembly"))
+		return currentContract.cachedArtifacts["legacyAssembly"];
 	else
 		return Json();
 }
@@ -1420,6 +1630,11 @@ void CompilerStack::assembleYul(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
+
+void CompilerStack::checkCodeSizeLimits(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (2^14 + 2^13) bytes,
@@ -1478,7 +1693,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_jobs);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1490,9 +1705,13 @@ void CompilerStack::compileContract(
 	_otherCompilers[compiledContract.contract] = compiler;
 
 	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	// Contracts served from the compilation cache are only compiled again because a contract
+	// that depends on them is compiled. Their size has been checked already.
+	if (compiledContract.cachedArtifacts.is_null())
+		checkCodeSizeLimits(_contract);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+void CompilerStack::generateIR(ContractDefinition const& _contract, bool _optimize)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1510,7 +1729,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generateIR(*dependency, _optimize);
 
 	if (!_contract.canBeDeployed())
 		return;
@@ -1554,28 +1773,94 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		);
 	}
 
-	yul::YulStack stack(
+	auto stack = std::make_shared<yul::YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", compiledContract.yulIR);
 	solAssert(
 		yulAnalysisSuccessful,
 		compiledContract.yulIR + "\n\n"
 		"Invalid IR generated:\n" +
-		langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		langutil::SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
-	compiledContract.yulIRAst = stack.astJson();
-	stack.optimize();
-	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+	compiledContract.yulStack = std::move(stack);
+
+	if (_optimize)
+		optimizeIR(_contract);
+}
+
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _jobs)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.yulStack, "");
+
+	// The IR of contracts created by this one is embedded as subobjects. These have already been
+	// optimized on their own, so the optimized objects are reused instead of optimizing them again.
+	std::map<YulString, std::shared_ptr<yul::Object const>> optimizedSubObjects;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		if (auto const& dependencyStack = m_contracts.at(dependency->fullyQualifiedName()).yulStack)
+			optimizedSubObjects.emplace(YulString(IRNames::creationObject(*dependency)), dependencyStack->parserResult());
+	if (m_profileOptimizer)
+	{
+		yul::OptimiserProfile profile;
+		compiledContract.yulStack->optimize(optimizedSubObjects, _jobs, &profile);
+		compiledContract.optimizerProfile = profile.toJson();
+	}
+	else
+		compiledContract.yulStack->optimize(optimizedSubObjects, _jobs);
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::optimizeIRAndGenerateEVMInParallel()
+{
+	// A contract is in wave n if the longest chain of contracts it creates has length n.
+	// All contracts of a wave are independent of each other.
+	std::map<ContractDefinition const*, size_t> waveOfContract;
+	std::function<size_t(ContractDefinition const&)> computeWave = [&](ContractDefinition const& _contract) -> size_t
+	{
+		if (auto it = waveOfContract.find(&_contract); it != waveOfContract.end())
+			return it->second;
+		size_t wave = 0;
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+			if (m_contracts.at(dependency->fullyQualifiedName()).yulStack)
+				wave = std::max(wave, computeWave(*dependency) + 1);
+		return waveOfContract[&_contract] = wave;
+	};
+
+	std::vector<std::vector<ContractDefinition const*>> waves;
+	for (auto const& [name, contract]: m_contracts)
+		if (contract.yulStack)
+		{
+			size_t wave = computeWave(*contract.contract);
+			if (waves.size() <= wave)
+				waves.resize(wave + 1);
+			waves[wave].push_back(contract.contract);
+		}
+
+	for (std::vector<ContractDefinition const*> const& wave: waves)
+	{
+		size_t const jobsPerContract = std::max<size_t>(m_jobs / wave.size(), 1);
+		util::parallelFor(wave.size(), m_jobs, [&](size_t _index) {
+			ContractDefinition const& contract = *wave[_index];
+			optimizeIR(contract, jobsPerContract);
+			if (m_generateEvmBytecode && m_viaIR && isRequestedContract(contract))
+				generateEVMFromIR(contract, jobsPerContract);
+		});
+	}
+
+	if (m_generateEvmBytecode && m_viaIR)
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+						checkCodeSizeLimits(*contract);
+}
+
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, size_t _jobs)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1583,29 +1868,204 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulStack, "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
-		m_evmVersion,
-		m_eofVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	solAssert(analysisSuccessful);
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
-
+	// The optimized IR object is already parsed and analyzed, so it can be assembled directly.
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = compiledContract.yulStack->assembleEVMWithDeployed(deployedName, _jobs);
 	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
+std::set<CompilerStack::Artifact> CompilerStack::artifactsToCache() const
+{
+	bool const generateIR = (m_generateEvmBytecode && m_viaIR) || m_generateIR;
+	std::set<Artifact> artifacts;
+	for (Artifact artifact: m_requestedArtifacts)
+		switch (artifact)
+		{
+		case Artifact::Assembly:
+		case Artifact::AssemblyJSON:
+		case Artifact::GasEstimates:
+		case Artifact::GeneratedSources:
+		case Artifact::SourceMappings:
+			if (m_generateEvmBytecode)
+				artifacts.insert(artifact);
+			break;
+		case Artifact::IROptimized:
+		case Artifact::IRAst:
+		case Artifact::IROptimizedAst:
+			if (generateIR)
+				artifacts.insert(artifact);
+			break;
+		}
+	return artifacts;
+}
+
+h256 CompilerStack::compilationCacheKey(Contract const& _contract) const
+{
+	Json key = Json::object();
+	key["metadata"] = metadata(_contract);
+	key["metadataFormat"] = static_cast<int>(m_metadataFormat);
+	key["debugInfo"] = util::toString(m_debugInfoSelection);
+	key["generateEvmBytecode"] = m_generateEvmBytecode;
+	key["generateIR"] = m_generateIR;
+	// Source indices are part of the assembly and the source mappings and depend on all sources,
+	// not only on the ones the contract imports.
+	key["sourceIndices"] = sourceIndices();
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCompilationCache(ContractDefinition const& _contract)
+{
+	solAssert(m_compilationCache);
+	solAssert(m_stackState >= AnalysisSuccessful);
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	h256 const key = compilationCacheKey(compiledContract);
+	std::optional<Json> artifacts = m_compilationCache->load(key);
+	if (!artifacts)
+		return false;
+
+	bool const generateIR = (m_generateEvmBytecode && m_viaIR) || m_generateIR;
+	std::set<Artifact> const cachedArtifacts = artifactsToCache();
+	auto const isCached = [&](Artifact _artifact) { return cachedArtifacts.count(_artifact) > 0; };
+	try
+	{
+		// Read everything before modifying the contract, so that an incomplete entry is ignored as a whole.
+		// The accessors throw Json::exception on missing members or members of the wrong type.
+		// Entries stored with fewer requested artifacts are therefore ignored and replaced.
+		evmasm::LinkerObject object;
+		evmasm::LinkerObject runtimeObject;
+		if (m_generateEvmBytecode)
+		{
+			object = CompilationCache::linkerObjectFromJson(artifacts->at("object"));
+			runtimeObject = CompilationCache::linkerObjectFromJson(artifacts->at("runtimeObject"));
+		}
+		std::string sourceMap;
+		std::string runtimeSourceMap;
+		if (isCached(Artifact::SourceMappings))
+		{
+			sourceMap = artifacts->at("sourceMap").get<std::string>();
+			runtimeSourceMap = artifacts->at("runtimeSourceMap").get<std::string>();
+		}
+		if (isCached(Artifact::Assembly))
+			artifacts->at("assembly").get<std::string>();
+		if (isCached(Artifact::AssemblyJSON))
+			artifacts->at("legacyAssembly");
+		if (isCached(Artifact::GasEstimates))
+			artifacts->at("gasEstimates");
+		if (isCached(Artifact::GeneratedSources))
+		{
+			artifacts->at("generatedSources");
+			artifacts->at("runtimeGeneratedSources");
+		}
+		std::string ir;
+		if (generateIR)
+			ir = artifacts->at("ir").get<std::string>();
+		std::string irOptimized;
+		if (isCached(Artifact::IROptimized))
+			irOptimized = artifacts->at("irOptimized").get<std::string>();
+		if (isCached(Artifact::IRAst))
+			artifacts->at("irAst");
+		if (isCached(Artifact::IROptimizedAst))
+			artifacts->at("irOptimizedAst");
+
+		if (m_generateEvmBytecode)
+		{
+			compiledContract.object = std::move(object);
+			compiledContract.runtimeObject = std::move(runtimeObject);
+		}
+		if (isCached(Artifact::SourceMappings))
+		{
+			compiledContract.sourceMapping.emplace(std::move(sourceMap));
+			compiledContract.runtimeSourceMapping.emplace(std::move(runtimeSourceMap));
+		}
+		if (isCached(Artifact::GeneratedSources))
+		{
+			compiledContract.generatedSources.init([&]{ return std::move((*artifacts)["generatedSources"]); });
+			compiledContract.runtimeGeneratedSources.init([&]{ return std::move((*artifacts)["runtimeGeneratedSources"]); });
+		}
+		if (generateIR)
+			compiledContract.yulIR = std::move(ir);
+		if (isCached(Artifact::IROptimized))
+			compiledContract.yulIROptimized.init([&]{ return std::move(irOptimized); });
+		if (isCached(Artifact::IRAst))
+			compiledContract.yulIRAst.init([&]{ return std::move((*artifacts)["irAst"]); });
+		if (isCached(Artifact::IROptimizedAst))
+			compiledContract.yulIROptimizedAst.init([&]{ return std::move((*artifacts)["irOptimizedAst"]); });
+	}
+	catch (Json::exception const&)
+	{
+		m_compilationCache->invalidate(key);
+		return false;
+	}
+
+	// The outputs derived from the EVM assembly are served from the entry by their accessors.
+	compiledContract.cachedArtifacts = Json::object();
+	for (auto const& [artifact, member]: std::map<Artifact, std::string>{
+		{Artifact::Assembly, "assembly"},
+		{Artifact::AssemblyJSON, "legacyAssembly"},
+		{Artifact::GasEstimates, "gasEstimates"}
+	})
+		if (isCached(artifact))
+			compiledContract.cachedArtifacts[member] = std::move((*artifacts)[member]);
+	return true;
+}
+
+void CompilerStack::storeInCompilationCache(ContractDefinition const& _contract)
+{
+	solAssert(m_compilationCache);
+	solAssert(m_stackState == CompilationSuccessful);
+
+	std::string const& contractName = _contract.fullyQualifiedName();
+	Contract const& compiledContract = m_contracts.at(contractName);
+
+	// Only the requested artifacts are generated, all others are left to later compilations.
+	std::set<Artifact> const cachedArtifacts = artifactsToCache();
+	auto const isCached = [&](Artifact _artifact) { return cachedArtifacts.count(_artifact) > 0; };
+	Json artifacts = Json::object();
+	if (m_generateEvmBytecode)
+	{
+		artifacts["object"] = CompilationCache::linkerObjectToJson(compiledContract.object);
+		artifacts["runtimeObject"] = CompilationCache::linkerObjectToJson(compiledContract.runtimeObject);
+	}
+	if (isCached(Artifact::Assembly))
+	{
+		StringMap sourceCodes;
+		for (auto const& [sourceName, source]: m_sources)
+			sourceCodes[sourceName] = source.charStream->source();
+		artifacts["assembly"] = assemblyString(contractName, sourceCodes);
+	}
+	if (isCached(Artifact::AssemblyJSON))
+		artifacts["legacyAssembly"] = assemblyJSON(contractName);
+	if (isCached(Artifact::SourceMappings))
+	{
+		std::string const* sourceMap = sourceMapping(contractName);
+		std::string const* runtimeSourceMap = runtimeSourceMapping(contractName);
+		artifacts["sourceMap"] = sourceMap ? *sourceMap : "";
+		artifacts["runtimeSourceMap"] = runtimeSourceMap ? *runtimeSourceMap : "";
+	}
+	if (isCached(Artifact::GasEstimates))
+		artifacts["gasEstimates"] = gasEstimates(contractName);
+	if (isCached(Artifact::GeneratedSources))
+	{
+		artifacts["generatedSources"] = generatedSourcesUncached(contractName, false);
+		artifacts["runtimeGeneratedSources"] = generatedSourcesUncached(contractName, true);
+	}
+	if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
+		artifacts["ir"] = compiledContract.yulIR;
+	if (isCached(Artifact::IROptimized))
+		artifacts["irOptimized"] = yulIROptimizedUncached(contractName);
+	if (isCached(Artifact::IRAst))
+		artifacts["irAst"] = yulIRAstUncached(contractName);
+	if (isCached(Artifact::IROptimizedAst))
+		artifacts["irOptimizedAst"] = yulIROptimizedAstUncached(contractName);
+	m_compilationCache->store(compilationCacheKey(compiledContract), artifacts);
+}
+
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1713,6 +2173,9 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["simpleCounterForLoopUncheckedIncrement"] = m_optimiserSettings.simpleCounterForLoopUncheckedIncrement;
+		// Only recorded if enabled, so that the metadata of existing settings does not change.
+		if (m_optimiserSettings.minimalTagPushes)
+			details["minimalTagPushes"] = true;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
@@ -1913,7 +2376,12 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 	solUnimplementedAssert(!isExperimentalSolidity());
 
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
+	{
+		Json const& cachedArtifacts = contract(_contractName).cachedArtifacts;
+		if (cachedArtifacts.contains("gasEstimates"))
+			return cachedArtifacts["gasEstimates"];
 		return Json();
+	}
 
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
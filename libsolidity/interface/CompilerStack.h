@@ -69,6 +69,11 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class YulStack;
+}
+
 namespace solidity::frontend
 {
 
@@ -78,8 +83,10 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
 class GlobalContext;
 class Natspec;
+class SMTQueryCache;
 class DeclarationContainer;
 namespace experimental
 {
@@ -119,6 +126,18 @@ public:
 		None
 	};
 
+	/// Artifacts that are not needed to generate the bytecode and are only produced when accessed.
+	enum class Artifact {
+		Assembly,
+		AssemblyJSON,
+		GasEstimates,
+		GeneratedSources,
+		SourceMappings,
+		IROptimized,
+		IRAst,
+		IROptimizedAst
+	};
+
 	enum class CompilationSourceType {
 		/// Regular compilation from Solidity source files.
 		Solidity,
@@ -168,6 +187,26 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used for compilation. Does not affect the output.
+	/// With more than one job, source units are parsed concurrently and the optimization and
+	/// assembly of the Yul IR of independent contracts is performed concurrently.
+	/// Must be set before compilation.
+	void setJobs(size_t _jobs);
+
+	/// Sets the cache used to store the artifacts of compiled contracts and to serve them
+	/// without running code generation again if their sources and the settings did not change.
+	/// Does not affect the output. Set to nullptr (the default) to disable caching.
+	/// Must be set before compilation.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache);
+
+	/// Sets the artifacts from @a Artifact that will be accessed after compilation. Only these
+	/// are produced for and stored in the compilation cache, and a cached contract is only served
+	/// if its entry contains all of them. All of them are requested by default.
+	/// Without a cache, this makes no difference: the optimized IR and the ASTs of the IR are
+	/// generated on first access, so nothing is generated for outputs that are not read.
+	/// Must be set before compilation.
+	void setRequestedArtifacts(std::set<Artifact> _artifacts);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -180,6 +219,11 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Sets the cache in which the model checker looks up the results of solver queries
+	/// before invoking a solver. Set to nullptr (the default) to disable caching.
+	/// Must be set before parsing.
+	void setSMTQueryCache(std::shared_ptr<SMTQueryCache> _cache);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -195,6 +239,10 @@ public:
 	/// Enable generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Enable recording the time spent in each step of the Yul optimizer and its effect
+	/// when optimizing the IR. Contracts are not served from the compilation cache then.
+	void enableOptimizerProfiling(bool _enable = true) { m_profileOptimizer = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -277,12 +325,22 @@ public:
 
 	/// @returns the IR representation of a contract AST in format.
 	Json const& yulIRAst(std::string const& _contractName) const;
+	/// Same as @a yulIRAst, but an AST that is not stored in the contract yet is not stored after generating it.
+	Json yulIRAstUncached(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
+	/// Same as @a yulIROptimized, but IR that is not stored in the contract yet is not stored after printing it.
+	std::string yulIROptimizedUncached(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract AST in JSON format.
 	Json const& yulIROptimizedAst(std::string const& _contractName) const;
+	/// Same as @a yulIROptimizedAst, but an AST that is not stored in the contract yet is not stored after generating it.
+	Json yulIROptimizedAstUncached(std::string const& _contractName) const;
+
+	/// @returns the record of the Yul optimizer steps run on the IR of a contract in JSON format
+	/// (see yul::OptimiserProfile) or null if optimizer profiling is not enabled.
+	Json const& optimizerProfile(std::string const& _contractName) const;
 
 	/// @returns the assembled object for a contract.
 	virtual evmasm::LinkerObject const& object(std::string const& _contractName) const override;
@@ -299,6 +357,8 @@ public:
 	/// @returns an array containing all utility sources generated during compilation.
 	/// Format: [ { name: string, id: number, language: "Yul", contents: string }, ... ]
 	Json generatedSources(std::string const& _contractName, bool _runtime = false) const;
+	/// Same as @a generatedSources, but sources that are not stored in the contract yet are not stored after generating them.
+	Json generatedSourcesUncached(std::string const& _contractName, bool _runtime = false) const;
 
 	/// @returns the string that provides a mapping between bytecode and sourcecode or a nullptr
 	/// if the contract does not (yet) have bytecode.
@@ -388,9 +448,13 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
-		Json yulIRAst; ///< JSON AST of Yul IR code.
-		Json yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		/// Yul stack holding the parsed, optimized and analyzed IR object.
+		/// Used directly for EVM code generation, so that the IR does not have to be re-parsed.
+		std::shared_ptr<yul::YulStack> yulStack;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized Yul IR code, printed on first access.
+		util::LazyInit<Json const> yulIRAst; ///< JSON AST of Yul IR code, generated on first access.
+		util::LazyInit<Json const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code, generated on first access.
+		Json optimizerProfile; ///< Record of the Yul optimizer steps run on the IR, if enabled.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -400,6 +464,9 @@ private:
 		util::LazyInit<Json const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Artifacts served from the compilation cache. Null if the contract was not found in the cache.
+		/// Used for the outputs that are otherwise derived from the EVM assembly.
+		Json cachedArtifacts;
 	};
 
 	void createAndAssignCallGraphs();
@@ -440,6 +507,11 @@ private:
 		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
 	);
 
+	/// Warns if the assembled bytecode of the contract exceeds the limits imposed by the EVM.
+	/// Kept separate from assembleYul, since the warnings have to be reported in a deterministic
+	/// order even when contracts are assembled concurrently.
+	void checkCodeSizeLimits(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -450,11 +522,42 @@ private:
 
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	/// If @a _optimize is false, the IR is only parsed and analyzed and optimizeIR has to be called later.
+	void generateIR(ContractDefinition const& _contract, bool _optimize = true);
+
+	/// Optimize the Yul IR of a single contract.
+	/// Depends on the IR of the contracts it creates being optimized already.
+	/// Independent functions of the contract are optimized using up to @a _jobs threads.
+	void optimizeIR(ContractDefinition const& _contract, size_t _jobs = 1);
+
+	/// Optimizes the IR of all contracts generated by generateIR with @a _optimize set to false
+	/// and generates EVM code for the requested ones, using up to m_jobs threads.
+	/// Contracts are processed in waves, so that the contracts created by a contract are always
+	/// finished before it is optimized. Threads not needed for the contracts of a wave are used
+	/// to optimize the functions of a contract concurrently.
+	void optimizeIRAndGenerateEVMInParallel();
 
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Independent sub-assemblies are optimised using up to @a _jobs threads.
+	void generateEVMFromIR(ContractDefinition const& _contract, size_t _jobs = 1);
+
+	/// @returns the requested artifacts that are produced with the current settings and therefore
+	/// stored in the compilation cache, in addition to the bytecode and the IR.
+	std::set<Artifact> artifactsToCache() const;
+
+	/// @returns the key of the contract in the compilation cache. It is derived from the metadata,
+	/// which covers the compiler version, the relevant settings and the hashes of all sources in
+	/// the import closure of the contract, and from the settings not included in the metadata.
+	util::h256 compilationCacheKey(Contract const& _contract) const;
+
+	/// Fills in the artifacts of the contract from the compilation cache.
+	/// @returns false if the contract is not in the cache.
+	bool loadFromCompilationCache(ContractDefinition const& _contract);
+
+	/// Stores the artifacts of the compiled contract in the compilation cache.
+	/// Can only be called after state is CompilationSuccessful and before linking.
+	void storeInCompilationCache(ContractDefinition const& _contract);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -508,12 +611,26 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_jobs = 1;
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	std::set<Artifact> m_requestedArtifacts = {
+		Artifact::Assembly,
+		Artifact::AssemblyJSON,
+		Artifact::GasEstimates,
+		Artifact::GeneratedSources,
+		Artifact::SourceMappings,
+		Artifact::IROptimized,
+		Artifact::IRAst,
+		Artifact::IROptimizedAst
+	};
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
+	std::shared_ptr<SMTQueryCache> m_smtQueryCache;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_profileOptimizer = false;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
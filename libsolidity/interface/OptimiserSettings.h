@@ -121,6 +121,7 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			minimalTagPushes == _other.minimalTagPushes &&
 			simpleCounterForLoopUncheckedIncrement == _other.simpleCounterForLoopUncheckedIncrement &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
@@ -149,6 +150,8 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Push every jump destination with the smallest width its position needs during assembly.
+	bool minimalTagPushes = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool simpleCounterForLoopUncheckedIncrement = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
@@ -19,10 +19,10 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/Keccak256.h>
-#include <libsolutil/TemporaryDirectory.h>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -41,6 +41,10 @@ void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMillisec
 {
 	m_arguments.clear();
 	m_solverCmd = "eld";
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_solverPath.reset();
+	}
 	if (timeoutInMilliseconds)
 	{
 		unsigned int timeoutInSeconds = timeoutInMilliseconds.value() / 1000u;
@@ -61,18 +65,24 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		if (m_solverCmd.empty())
 			return ReadCallback::Result{false, "No solver set."};
 
-		auto tempDir = solidity::util::TemporaryDirectory("smt");
-		util::h256 queryHash = util::keccak256(_query);
-		auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
-
-		auto queryFile = boost::filesystem::ofstream(queryFileName);
-		queryFile << _query << std::flush;
-
-		auto eldBin = boost::process::search_path(m_solverCmd);
+		auto eldBin = solverPath();
 
 		if (eldBin.empty())
 			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
 
+		util::h256 queryHash = util::keccak256(_query);
+		auto queryFileName = queryDirectory() / ("query_" + std::to_string(m_queryCounter++) + "_" + queryHash.hex() + ".smt2");
+		// The file is only needed while the solver runs, the directory is reused for all queries.
+		ScopeGuard removeQueryFile([&] {
+			boost::system::error_code error;
+			boost::filesystem::remove(queryFileName, error);
+		});
+
+		{
+			auto queryFile = boost::filesystem::ofstream(queryFileName);
+			queryFile << _query << std::flush;
+		}
+
 		auto args = m_arguments;
 		args.push_back(queryFileName.string());
 
@@ -100,4 +110,21 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 	}
 }
 
+boost::filesystem::path SMTSolverCommand::solverPath()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// Searching PATH for every query is noticeable with thousands of queries.
+	if (!m_solverPath)
+		m_solverPath = boost::process::search_path(m_solverCmd);
+	return *m_solverPath;
+}
+
+boost::filesystem::path const& SMTSolverCommand::queryDirectory()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_queryDirectory)
+		m_queryDirectory = std::make_unique<util::TemporaryDirectory>("smt");
+	return m_queryDirectory->path();
+}
+
 }
@@ -19,16 +19,28 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsolutil/TemporaryDirectory.h>
+
 #include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace solidity::frontend
 {
 
 /// SMTSolverCommand wraps an SMT solver called via its binary in the OS.
+///
+/// Every query starts a new solver process. The only solver supported here is Eldarica, which
+/// reads a complete Horn problem from a file and has no interactive mode, so a long-lived process
+/// that receives incremental push/pop commands is not possible. The solvers that do support
+/// incremental solving are linked into the compiler and never use this command.
 class SMTSolverCommand
 {
 public:
 	/// Calls an SMT solver with the given query.
+	/// Can be called concurrently, e.g. by BMC checking targets on multiple threads.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query);
 
 	frontend::ReadCallback::Callback solver()
@@ -39,9 +51,23 @@ public:
 	void setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants);
 
 private:
+	/// @returns the path of the solver's binary, which is looked up only once per solver,
+	/// or an empty path if it was not found.
+	boost::filesystem::path solverPath();
+	/// @returns the directory the queries are written to, which is created only once
+	/// and removed together with this object.
+	boost::filesystem::path const& queryDirectory();
+
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+
+	/// Guards the lazily initialized members below.
+	std::mutex m_mutex;
+	std::optional<boost::filesystem::path> m_solverPath;
+	std::unique_ptr<util::TemporaryDirectory> m_queryDirectory;
+	/// Makes the names of query files unique, also for equal queries solved at the same time.
+	std::atomic<size_t> m_queryCounter = 0;
 };
 
 }
@@ -22,12 +22,15 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <libevmasm/Disassemble.h>
 #include <libevmasm/EVMAssemblyStack.h>
@@ -44,6 +47,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -179,7 +183,7 @@ bool hashMatchesContent(std::string const& _hash, std::string const& _content)
 
 bool isArtifactRequested(Json const& _outputSelection, std::string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static std::set<std::string> experimental{"ir", "irAst", "irOptimized", "irOptimizedAst"};
+	static std::set<std::string> experimental{"ir", "irAst", "irOptimized", "irOptimizedAst", "optimizerProfile"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		std::string const& selectedArtifact = selectedArtifactJson.get<std::string>();
@@ -315,6 +319,52 @@ bool isIRRequested(Json const& _outputSelection)
 	return false;
 }
 
+/// @returns the artifacts produced on access by the compiler stack that were requested for any contract.
+std::set<CompilerStack::Artifact> requestedArtifacts(Json const& _outputSelection)
+{
+	using Artifact = CompilerStack::Artifact;
+	static std::map<Artifact, std::vector<std::string>> const outputsOfArtifacts{
+		{Artifact::Assembly, {"evm.assembly"}},
+		{Artifact::AssemblyJSON, {"evm.legacyAssembly"}},
+		{Artifact::GasEstimates, {"evm.gasEstimates"}},
+		{Artifact::GeneratedSources, {"evm.bytecode.generatedSources", "evm.deployedBytecode.generatedSources"}},
+		{Artifact::SourceMappings, {"evm.bytecode.sourceMap", "evm.deployedBytecode.sourceMap"}},
+		{Artifact::IROptimized, {"irOptimized"}},
+		{Artifact::IRAst, {"irAst"}},
+		{Artifact::IROptimizedAst, {"irOptimizedAst"}}
+	};
+
+	std::set<Artifact> artifacts;
+	if (!_outputSelection.is_object())
+		return artifacts;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& [artifact, outputs]: outputsOfArtifacts)
+				for (auto const& output: outputs)
+					if (isArtifactRequested(requests, output, false))
+						artifacts.insert(artifact);
+	return artifacts;
+}
+
+/// @returns true if the profile of the Yul optimizer was requested for any contract.
+/// It is never matched by '*', since it slows down the compilation and is not deterministic.
+/// The profile does not cause the IR to be generated or optimized by itself, it only records
+/// the optimization done for the other requested outputs.
+bool isOptimizerProfileRequested(Json const& _outputSelection)
+{
+	if (!_outputSelection.is_object())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "optimizerProfile")
+					return true;
+
+	return false;
+}
+
 Json formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json ret = Json::object();
@@ -424,13 +474,13 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "jobs", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "detectSolverConflicts", "divModNoSlacks", "engine", "extCalls", "invariants", "jobs", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -442,7 +492,7 @@ std::optional<Json> checkOptimizerKeys(Json const& _input)
 
 std::optional<Json> checkOptimizerDetailsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
+	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement", "minimalTagPushes"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -606,6 +656,8 @@ std::variant<OptimiserSettings, Json> parseOptimizerSettings(Json const& _jsonIn
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "simpleCounterForLoopUncheckedIncrement", settings.simpleCounterForLoopUncheckedIncrement))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "minimalTagPushes", settings.minimalTagPushes))
+			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		if (details.contains("yulDetails"))
 		{
@@ -815,6 +867,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("jobs"))
+	{
+		if (!settings["jobs"].is_number_unsigned() || settings["jobs"].get<Json::number_unsigned_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.jobs\" must be a positive integer.");
+		ret.jobs = settings["jobs"].get<size_t>();
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1029,6 +1088,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.contracts = {std::move(sourceContracts)};
 	}
 
+	if (modelCheckerSettings.contains("detectSolverConflicts"))
+	{
+		auto const& detectSolverConflicts = modelCheckerSettings["detectSolverConflicts"];
+		if (!detectSolverConflicts.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.detectSolverConflicts must be a Boolean.");
+		ret.modelCheckerSettings.detectSolverConflicts = detectSolverConflicts.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("divModNoSlacks"))
 	{
 		auto const& divModNoSlacks = modelCheckerSettings["divModNoSlacks"];
@@ -1088,6 +1155,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.contains("jobs"))
+	{
+		auto const& jobs = modelCheckerSettings["jobs"];
+		if (!jobs.is_number_unsigned() || jobs.get<Json::number_unsigned_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.jobs must be a positive integer.");
+		ret.modelCheckerSettings.jobs = jobs.get<unsigned>();
+	}
+
 	if (modelCheckerSettings.contains("showProvedSafe"))
 	{
 		auto const& showProvedSafe = modelCheckerSettings["showProvedSafe"];
@@ -1293,7 +1368,7 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 	return util::removeNullMembers(output);
 }
 
-Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, util::JsonWriter& _output)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
@@ -1305,6 +1380,14 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setJobs(_inputsAndSettings.jobs);
+	compilerStack.setCompilationCache(m_compilationCache);
+	// Statistics are reported per compilation, even if the cache is shared between several of them.
+	std::optional<CompilationCache::Statistics> const initialCacheStatistics =
+		m_compilationCache ? std::make_optional(m_compilationCache->statistics()) : std::nullopt;
+	compilerStack.setSMTQueryCache(m_smtQueryCache);
+	std::optional<CompilationCache::Statistics> const initialQueryCacheStatistics =
+		m_smtQueryCache ? std::make_optional(m_smtQueryCache->statistics()) : std::nullopt;
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1320,6 +1403,8 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableOptimizerProfiling(isOptimizerProfileRequested(_inputsAndSettings.outputSelection));
+	compilerStack.setRequestedArtifacts(requestedArtifacts(_inputsAndSettings.outputSelection));
 
 	Json errors = std::move(_inputsAndSettings.errors);
 
@@ -1469,133 +1554,169 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 		(compilationFailed || analysisFailed || !parsingSuccess) &&
 		errors.empty()
 	)
-		return formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed.");
-
-	Json output;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	{
+		_output.writeMembers(formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed."));
+		return;
+	}
 
+	// The artifacts are written one by one as soon as they are generated and are not kept around
+	// afterwards, so they have to be produced in the order in which their keys are sorted.
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json auxiliaryInput;
 		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInput["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.write("auxiliaryInputRequested", std::move(auxiliaryInput));
+	}
 
-	bool const wildcardMatchesExperimental = false;
+	if (m_compilationCache)
+	{
+		CompilationCache::Statistics const& statistics = m_compilationCache->statistics();
+		Json cacheStatistics;
+		cacheStatistics["hits"] = statistics.hits - initialCacheStatistics->hits;
+		cacheStatistics["misses"] = statistics.misses - initialCacheStatistics->misses;
+		cacheStatistics["evictions"] = statistics.evictions - initialCacheStatistics->evictions;
+		_output.write("compilationCache", std::move(cacheStatistics));
+	}
 
-	output["sources"] = Json::object();
-	unsigned sourceIndex = 0;
-	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
-	// stopAfter: parsing with no parsing errors.
-	if (parsingSuccess && !analysisFailed)
-		for (std::string const& sourceName: compilerStack.sourceNames())
-		{
-			Json sourceResult;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
+	bool const wildcardMatchesExperimental = false;
 
-	Json contractsOutput;
+	std::map<std::string, std::vector<std::string>> contractNamesByFile;
 	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json contractData;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
-
-		// EVM
-		Json evmData;
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		contractNamesByFile[contractName.substr(0, colon)].push_back(contractName.substr(colon + 1));
+	}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](std::string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	_output.beginObject("contracts");
+	for (auto const& [file, names]: contractNamesByFile)
+	{
+		_output.beginObject(file);
+		for (std::string const& name: names)
+		{
+			std::string const contractName = file + ":" + name;
+			_output.beginObject(name);
+
+			// ABI, documentation and EVM
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				_output.write("abi", compilerStack.contractABI(contractName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				_output.write("devdoc", compilerStack.natspecDev(contractName));
+
+			_output.beginObject("evm");
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				_output.write("assembly", compilerStack.assemblyString(contractName, sourceList));
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("bytecode"),
+				wildcardMatchesExperimental
+			))
+				_output.write("bytecode", collectEVMObject(
+					_inputsAndSettings.evmVersion,
+					compilerStack.object(contractName),
+					compilerStack.sourceMapping(contractName),
+					compilerStack.generatedSourcesUncached(contractName),
+					false,
+					[&](std::string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.bytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				));
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents("deployedBytecode"),
+				wildcardMatchesExperimental
+			))
+				_output.write("deployedBytecode", collectEVMObject(
+					_inputsAndSettings.evmVersion,
+					compilerStack.runtimeObject(contractName),
+					compilerStack.runtimeSourceMapping(contractName),
+					compilerStack.generatedSourcesUncached(contractName, true),
+					true,
+					[&](std::string const& _element) { return isArtifactRequested(
+						_inputsAndSettings.outputSelection,
+						file,
+						name,
+						"evm.deployedBytecode." + _element,
+						wildcardMatchesExperimental
+					); }
+				));
 
-		if (!contractData.empty())
-		{
-			if (!contractsOutput.contains(file))
-				contractsOutput[file] = Json::object();
-			contractsOutput[file][name] = contractData;
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				_output.write("gasEstimates", compilerStack.gasEstimates(contractName));
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+				_output.write("legacyAssembly", compilerStack.assemblyJSON(contractName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				_output.write("methodIdentifiers", compilerStack.interfaceSymbols(contractName)["methods"]);
+			_output.endObject();
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				_output.write("ir", compilerStack.yulIR(contractName));
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
+				_output.write("irAst", compilerStack.yulIRAstUncached(contractName));
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				_output.write("irOptimized", compilerStack.yulIROptimizedUncached(contractName));
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
+				_output.write("irOptimizedAst", compilerStack.yulIROptimizedAstUncached(contractName));
+
+			// Metadata, optimizer profile, storage layout and user documentation
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				_output.write("metadata", compilerStack.metadata(contractName));
+			if (
+				compilationSuccess &&
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "optimizerProfile", wildcardMatchesExperimental) &&
+				!compilerStack.optimizerProfile(contractName).is_null()
+			)
+				_output.write("optimizerProfile", compilerStack.optimizerProfile(contractName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+				_output.write("storageLayout", compilerStack.storageLayout(contractName));
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				_output.write("userdoc", compilerStack.natspecUser(contractName));
+
+			_output.endObject();
 		}
+		_output.endObject();
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+	_output.endObject();
 
-	return output;
+	if (errors.size() > 0)
+		_output.write("errors", std::move(errors));
+
+	if (m_smtQueryCache)
+	{
+		CompilationCache::Statistics const& statistics = m_smtQueryCache->statistics();
+		Json cacheStatistics;
+		cacheStatistics["hits"] = statistics.hits - initialQueryCacheStatistics->hits;
+		cacheStatistics["misses"] = statistics.misses - initialQueryCacheStatistics->misses;
+		cacheStatistics["evictions"] = statistics.evictions - initialQueryCacheStatistics->evictions;
+		_output.write("modelCheckerCache", std::move(cacheStatistics));
+	}
+
+	_output.beginObject("sources", true);
+	unsigned sourceIndex = 0;
+	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
+	// stopAfter: parsing with no parsing errors.
+	if (parsingSuccess && !analysisFailed)
+		for (std::string const& sourceName: compilerStack.sourceNames())
+		{
+			_output.beginObject(sourceName, true);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				_output.write("ast", ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName)));
+			_output.write("id", sourceIndex++);
+			_output.endObject();
+		}
+	_output.endObject();
 }
 
 
@@ -1696,7 +1817,15 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		sourceResult["ast"] = stack.astJson();
 		output["sources"][sourceName] = sourceResult;
 	}
-	stack.optimize();
+	// Not matched by '*', even though other IR outputs are.
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "optimizerProfile", false))
+	{
+		yul::OptimiserProfile profile;
+		stack.optimize({}, 1, &profile);
+		output["contracts"][sourceName][contractName]["optimizerProfile"] = profile.toJson();
+	}
+	else
+		stack.optimize();
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject deployedObject;
@@ -1744,58 +1873,83 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 Json StandardCompiler::compile(Json const& _input) noexcept
+{
+	Json output;
+	util::JsonWriter writer(output);
+	// A fatal error replaces the whole document, so it is always part of the output.
+	compile(_input, writer);
+	writer.finish();
+	return output;
+}
+
+std::optional<std::string> StandardCompiler::compile(Json const& _input, util::JsonWriter& _output)
 {
 	YulStringRepository::reset();
 
+	std::optional<Json> fatalError;
 	try
 	{
 		auto parsed = parseInput(_input);
 		if (std::holds_alternative<Json>(parsed))
-			return std::get<Json>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
+			_output.writeMembers(std::get<Json>(std::move(parsed)));
 		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
+		{
+			InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+			if (settings.language == "Solidity")
+				compileSolidity(std::move(settings), _output);
+			else if (settings.language == "Yul")
+				_output.writeMembers(compileYul(std::move(settings)));
+			else if (settings.language == "SolidityAST")
+				compileSolidity(std::move(settings), _output);
+			else if (settings.language == "EVMAssembly")
+				_output.writeMembers(importEVMAssembly(std::move(settings)));
+			else
+				_output.writeMembers(formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language."));
+		}
 	}
 	catch (Json::parse_error const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON parse_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON parse_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (Json::invalid_iterator const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON invalid_iterator exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON invalid_iterator exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (Json::type_error const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON type_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON type_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (Json::out_of_range const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON out_of_range exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON out_of_range exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (Json::other_error const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON other_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON other_error exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (Json::exception const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, std::string("JSON runtime exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, std::string("JSON runtime exception: ") + util::removeNlohmannInternalErrorIdentifier(_exception.what()));
 	}
 	catch (util::Exception const& _exception)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		fatalError = formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
 	}
+
+	if (!fatalError)
+		return std::nullopt;
+
+	// Members that have already been printed stay in the output and the error becomes its "errors"
+	// member. If that has been printed, too, the error cannot be added and is returned instead.
+	_output.discard();
+	if (_output.hasMember("errors"))
+		return (*fatalError)["errors"][0]["message"].get<std::string>();
+	_output.writeMembers(std::move(*fatalError));
+	return std::nullopt;
 }
 
 std::string StandardCompiler::compile(std::string const& _input) noexcept
@@ -1815,9 +1969,7 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON: " + errors + "\"}]}";
 	}
 
-//	std::cout << "Input: " << solidity::util::jsonPrettyPrint(input) << std::endl;
 	Json output = compile(input);
-//	std::cout << "Output: " << solidity::util::jsonPrettyPrint(output) << std::endl;
 
 	try
 	{
@@ -1829,6 +1981,35 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+std::optional<std::string> StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
+{
+	Json input;
+	std::string errors;
+	try
+	{
+		if (!util::jsonParseStrict(_input, input, &errors))
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return std::nullopt;
+		}
+	}
+	catch (...)
+	{
+		if (errors.empty())
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		else
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON: " + errors + "\"}]}";
+		return std::nullopt;
+	}
+
+	// Errors while printing a member are fatal errors of compile(), which closes the objects
+	// printed so far. Nothing else is printed afterwards, so there is no second top-level object.
+	util::JsonWriter writer(_output, m_jsonPrintingFormat);
+	std::optional<std::string> fatalError = compile(input, writer);
+	writer.finish();
+	return fatalError;
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -28,7 +28,9 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -56,12 +58,26 @@ public:
 	{
 	}
 
+	/// Reuses compiled contracts from @a _cache. The cache directory is deliberately not part of
+	/// the JSON input, because the input must not be able to choose which files the compiler writes to.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
+	/// Reuses the results of model checker queries from @a _cache. Like the compilation cache,
+	/// it can only be chosen by the caller, not by the JSON input.
+	void setSMTQueryCache(std::shared_ptr<SMTQueryCache> _cache) { m_smtQueryCache = std::move(_cache); }
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json compile(Json const& _input) noexcept;
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but prints the output to @a _output while it is generated, so that
+	/// the artifacts of all contracts never have to be held in memory at the same time.
+	/// The members printed before a fatal error stay in the output, which is closed and
+	/// gets the error as its "errors" member. If that member has already been printed,
+	/// the error cannot be added to the output.
+	/// @returns the message of a fatal error that could not be added to the output.
+	std::optional<std::string> compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,20 +105,29 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t jobs = 1;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
+	/// Performs the processing steps of the public overloads and writes the output to @a _output.
+	/// @returns the message of a fatal error that could not be written because the "errors"
+	/// member had already been printed.
+	std::optional<std::string> compile(Json const& _input, util::JsonWriter& _output);
+
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonWriter& _output);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	std::shared_ptr<SMTQueryCache> m_smtQueryCache;
 };
 
 }
@@ -48,6 +48,12 @@ FileRepository::FileRepository(boost::filesystem::path _basePath, std::vector<bo
 {
 }
 
+void FileRepository::clearSourceUnits()
+{
+	m_sourceUnitNamesToUri.clear();
+	m_sourceCodes.clear();
+}
+
 void FileRepository::setIncludePaths(std::vector<boost::filesystem::path> _paths)
 {
 	m_includePaths = std::move(_paths);
@@ -165,10 +171,10 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 		if (!resolvedPath.message().empty())
 			return ReadCallback::Result{false, resolvedPath.message()};
 
-		auto contents = readFileAsString(resolvedPath.get());
+		std::string const& contents = readFileFromDisk(resolvedPath.get());
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, std::move(contents)};
+		return ReadCallback::Result{true, contents};
 	}
 	catch (std::exception const& _exception)
 	{
@@ -180,3 +186,12 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 	}
 }
 
+std::string const& FileRepository::readFileFromDisk(boost::filesystem::path const& _path)
+{
+	std::time_t const lastWriteTime = boost::filesystem::last_write_time(_path);
+	std::uintmax_t const size = boost::filesystem::file_size(_path);
+	auto file = m_filesOnDisk.find(_path);
+	if (file == m_filesOnDisk.end() || file->second.lastWriteTime != lastWriteTime || file->second.size != size)
+		file = m_filesOnDisk.insert_or_assign(_path, FileOnDisk{lastWriteTime, size, readFileAsString(_path)}).first;
+	return file->second.content;
+}
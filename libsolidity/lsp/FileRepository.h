@@ -20,6 +20,8 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
+#include <cstdint>
+#include <ctime>
 #include <string>
 #include <map>
 
@@ -49,6 +51,9 @@ public:
 	void setSourceByUri(std::string const& _uri, std::string _text);
 
 	void setSourceUnits(StringMap _sources);
+	/// Removes all sources, so that they are read again on the next access. Files are only read
+	/// from disk again if their modification time or size changed since they were last read.
+	void clearSourceUnits();
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 	frontend::ReadCallback::Callback reader()
 	{
@@ -57,6 +62,10 @@ public:
 
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
+	/// @returns the content of the file at @a _path. It is only read from disk again if the
+	/// modification time or the size of the file changed since it was last read.
+	std::string const& readFileFromDisk(boost::filesystem::path const& _path);
+
 private:
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
@@ -69,6 +78,15 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	struct FileOnDisk
+	{
+		std::time_t lastWriteTime;
+		std::uintmax_t size;
+		std::string content;
+	};
+	/// Content of the files read from disk, by path. It is kept when the sources are cleared.
+	std::map<boost::filesystem::path, FileOnDisk> m_filesOnDisk;
 };
 
 }
@@ -41,8 +41,13 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <range/v3/algorithm/all_of.hpp>
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/view/map.hpp>
+
 #include <ostream>
 #include <string>
+#include <thread>
 
 #include <fmt/format.h>
 
@@ -59,6 +64,18 @@ namespace fs = boost::filesystem;
 namespace
 {
 
+/// Time without further messages after which changes are compiled.
+std::chrono::milliseconds constexpr compilationDelay{200};
+
+/// Requests answered from the analysis, which have to see all changes received before them.
+/// Hover and semantic tokens requests are answered from the last analysis instead, so that
+/// they do not wait for a compilation while the user is typing.
+std::set<std::string> const requestsReadingAnalysis{
+	"textDocument/definition",
+	"textDocument/implementation",
+	"textDocument/rename",
+};
+
 bool resolvesToRegularFile(boost::filesystem::path _path, int maxRecursionDepth = 10)
 {
 	fs::file_status fileStatus = fs::status(_path);
@@ -134,8 +151,8 @@ Json semanticTokensLegend()
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		{"$/cancelRequest", [](auto, auto) {/* handled when receiving messages */}},
+		{"cancelRequest", [](auto, auto) {/* handled when receiving messages */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
@@ -189,6 +206,8 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	// The configuration can change how sources are loaded and analyzed, so nothing can be reused.
+	m_analyzedSourceUnits.clear();
 	Json jsonIncludePaths = _settings.contains("include-paths") ? _settings["include-paths"] : Json::object();
 
 	if (!jsonIncludePaths.empty())
@@ -236,13 +255,14 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+void LanguageServer::compile(std::set<std::string> const& _requiredSourceUnits)
 {
 	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
-
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	// so we just remove all non-open files. Files that did not change on disk are not read again.
+	std::map<std::string, std::string> openFileContents;
+	for (std::string const& fileName: m_openFiles)
+		openFileContents[fileName] = m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(fileName));
+	m_fileRepository.clearSourceUnits();
 
 	// Load all solidity files from project.
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
@@ -251,34 +271,107 @@ void LanguageServer::compile()
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
 			m_fileRepository.setSourceByUri(
 				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+				m_fileRepository.readFileFromDisk(projectFile)
 			);
 		}
 
 	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+	for (auto&& [fileName, content]: openFileContents)
+		m_fileRepository.setSourceByUri(fileName, std::move(content));
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	// Files that are only imported are loaded by the compiler, but unchanged source units
+	// might not be passed to the compiler, so we load their imports here.
+	std::vector<std::string> unchangedSourceUnits;
+	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+		if (analyzedAndUnchanged(sourceUnitName))
+			unchangedSourceUnits.push_back(sourceUnitName);
+	while (!unchangedSourceUnits.empty())
+	{
+		std::string const sourceUnitName = std::move(unchangedSourceUnits.back());
+		unchangedSourceUnits.pop_back();
+		for (std::string const& importedSourceUnitName: m_analyzedSourceUnits.at(sourceUnitName).imports)
+			if (
+				!m_fileRepository.sourceUnits().count(importedSourceUnitName) &&
+				m_fileRepository.readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importedSourceUnitName).success &&
+				analyzedAndUnchanged(importedSourceUnitName)
+			)
+				unchangedSourceUnits.push_back(importedSourceUnitName);
+	}
+
+	std::set<std::string> sourceUnitsToAnalyze = affectedSourceUnits();
+	std::vector<std::string> const sourceUnitsInCompilerStack = m_compilerStack.sourceNames();
+	bool const requiredSourceUnitsAnalyzed = ranges::all_of(_requiredSourceUnits, [&](std::string const& _sourceUnitName) {
+		return
+			!m_fileRepository.sourceUnits().count(_sourceUnitName) ||
+			util::contains(sourceUnitsInCompilerStack, _sourceUnitName);
+	});
+	if (sourceUnitsToAnalyze.empty() && requiredSourceUnitsAnalyzed)
+		return;
+	sourceUnitsToAnalyze += _requiredSourceUnits;
+
+	// Source units imported by the ones to analyze are loaded by the compiler as usual.
+	StringMap sources;
+	for (std::string const& sourceUnitName: sourceUnitsToAnalyze)
+		if (m_fileRepository.sourceUnits().count(sourceUnitName))
+			sources[sourceUnitName] = m_fileRepository.sourceUnits().at(sourceUnitName);
+	lspDebug(fmt::format("analyzing {} of {} source units", sources.size(), m_fileRepository.sourceUnits().size()));
 
 	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
+	m_compilerStack.setSources(std::move(sources));
 	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+
+	recordAnalysis();
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+bool LanguageServer::analyzedAndUnchanged(std::string const& _sourceUnitName) const
 {
-	compile();
+	auto const analyzedSourceUnit = m_analyzedSourceUnits.find(_sourceUnitName);
+	return
+		analyzedSourceUnit != m_analyzedSourceUnits.end() &&
+		m_fileRepository.sourceUnits().count(_sourceUnitName) &&
+		analyzedSourceUnit->second.content == m_fileRepository.sourceUnits().at(_sourceUnitName);
+}
 
-	// These are the source units we will sent diagnostics to the client for sure,
-	// even if it is just to clear previous diagnostics.
-	std::map<std::string, Json> diagnosticsBySourceUnit;
+std::set<std::string> LanguageServer::affectedSourceUnits() const
+{
+	std::set<std::string> affectedSourceUnits;
 	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
-	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
+		if (!analyzedAndUnchanged(sourceUnitName))
+			affectedSourceUnits.insert(sourceUnitName);
+	// Removed source units affect the source units importing them.
+	for (std::string const& sourceUnitName: m_analyzedSourceUnits | ranges::views::keys)
+		if (!m_fileRepository.sourceUnits().count(sourceUnitName))
+			affectedSourceUnits.insert(sourceUnitName);
+
+	std::map<std::string, std::set<std::string>> importingSourceUnits;
+	for (auto const& [sourceUnitName, analyzedSourceUnit]: m_analyzedSourceUnits)
+		for (std::string const& importedSourceUnitName: analyzedSourceUnit.imports)
+			importingSourceUnits[importedSourceUnitName].insert(sourceUnitName);
+
+	std::vector<std::string> worklist(affectedSourceUnits.begin(), affectedSourceUnits.end());
+	while (!worklist.empty())
+	{
+		std::string const sourceUnitName = std::move(worklist.back());
+		worklist.pop_back();
+		for (std::string const& importingSourceUnitName: util::valueOrDefault(importingSourceUnits, sourceUnitName))
+			if (affectedSourceUnits.insert(importingSourceUnitName).second)
+				worklist.push_back(importingSourceUnitName);
+	}
+
+	return affectedSourceUnits;
+}
+
+void LanguageServer::recordAnalysis()
+{
+	for (auto it = m_analyzedSourceUnits.begin(); it != m_analyzedSourceUnits.end();)
+		if (m_fileRepository.sourceUnits().count(it->first))
+			++it;
+		else
+			it = m_analyzedSourceUnits.erase(it);
+
+	std::map<std::string, Json> diagnosticsBySourceUnit;
+	std::set<std::string> sourceUnitsWithErrors;
+	for (std::string const& sourceUnitName: m_compilerStack.sourceNames())
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 
 	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
@@ -308,7 +401,58 @@ void LanguageServer::compileAndUpdateDiagnostics()
 			}
 
 		diagnosticsBySourceUnit[*location->sourceName].emplace_back(jsonDiag);
+		if (Error::isError(error->type()))
+			sourceUnitsWithErrors.insert(*location->sourceName);
+	}
+
+	bool const analysisSuccessful = m_compilerStack.state() >= CompilerStack::AnalysisSuccessful;
+	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
+	{
+		if (!m_fileRepository.sourceUnits().count(sourceUnitName))
+			continue;
+
+		AnalyzedSourceUnit& analyzedSourceUnit = m_analyzedSourceUnits[sourceUnitName];
+		// If the analysis stopped early due to errors elsewhere, further diagnostics might be
+		// missing, so the source unit has to be analyzed again.
+		if (analysisSuccessful || sourceUnitsWithErrors.count(sourceUnitName))
+			analyzedSourceUnit.content = m_fileRepository.sourceUnits().at(sourceUnitName);
+		else
+			analyzedSourceUnit.content.reset();
+		if (m_compilerStack.state() >= CompilerStack::Parsed)
+		{
+			analyzedSourceUnit.imports.clear();
+			for (auto const* import: ASTNode::filteredNodes<ImportDirective>(m_compilerStack.ast(sourceUnitName).nodes()))
+				analyzedSourceUnit.imports.insert(import->annotation().absolutePath);
+		}
+		analyzedSourceUnit.diagnostics = std::move(diagnostics);
 	}
+}
+
+void LanguageServer::requireAnalysis(std::set<std::string> const& _sourceUnitNames)
+{
+	compile(_sourceUnitNames);
+}
+
+void LanguageServer::scheduleCompileAndUpdateDiagnostics()
+{
+	m_scheduledCompilation = std::chrono::steady_clock::now() + compilationDelay;
+}
+
+void LanguageServer::compileAndUpdateDiagnostics()
+{
+	m_scheduledCompilation.reset();
+	compile();
+
+	// These are the source units we will sent diagnostics to the client for sure,
+	// even if it is just to clear previous diagnostics.
+	std::map<std::string, Json> diagnosticsBySourceUnit;
+	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+		if (m_analyzedSourceUnits.count(sourceUnitName))
+			diagnosticsBySourceUnit[sourceUnitName] = m_analyzedSourceUnits.at(sourceUnitName).diagnostics;
+		else
+			diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
+		diagnosticsBySourceUnit.emplace(sourceUnitName, Json::array());
 
 	if (m_client.traceValue() != TraceValue::Off)
 	{
@@ -331,20 +475,33 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	std::thread receiver([this]() { receiveMessages(); });
+
+	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown)
 	{
 		MessageID id;
 		try
 		{
-			std::optional<Json> const jsonMessage = m_client.receive();
+			std::optional<Json> const jsonMessage = nextMessage();
 			if (!jsonMessage)
+			{
+				if (!m_scheduledCompilation)
+					break;
+				compileAndUpdateDiagnostics();
 				continue;
+			}
 
 			if ((*jsonMessage).contains("method") && (*jsonMessage)["method"].is_string())
 			{
 				std::string const methodName = (*jsonMessage)["method"].get<std::string>();
 				if ((*jsonMessage).contains("id"))
+				{
 					id = (*jsonMessage)["id"];
+					// Compiling the pending changes right away also publishes their diagnostics,
+					// so that the client never sees results from an older analysis than the diagnostics.
+					if (m_scheduledCompilation && requestsReadingAnalysis.count(methodName))
+						compileAndUpdateDiagnostics();
+				}
 				lspDebug(fmt::format("received method call: {}", methodName));
 
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
@@ -368,9 +525,91 @@ bool LanguageServer::run()
 			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
 	}
+
+	receiver.join();
 	return m_state == State::ExitRequested;
 }
 
+void LanguageServer::receiveMessages()
+{
+	while (!m_client.closed())
+	{
+		std::optional<Json> jsonMessage;
+		try
+		{
+			jsonMessage = m_client.receive();
+		}
+		catch (...)
+		{
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+		if (!jsonMessage)
+			continue;
+
+		std::string const methodName =
+			jsonMessage->contains("method") && (*jsonMessage)["method"].is_string() ?
+			(*jsonMessage)["method"].get<std::string>() :
+			"";
+
+		if (
+			(methodName == "$/cancelRequest" || methodName == "cancelRequest") &&
+			jsonMessage->contains("params") &&
+			(*jsonMessage)["params"].contains("id")
+		)
+		{
+			MessageID const cancelledID = (*jsonMessage)["params"]["id"];
+			bool cancelled = false;
+			{
+				std::lock_guard lock(m_messageQueueMutex);
+				auto const cancelledMessage = ranges::find_if(m_messageQueue, [&](Json const& _message) {
+					return _message.contains("id") && _message["id"] == cancelledID;
+				});
+				if (cancelledMessage != m_messageQueue.end())
+				{
+					m_messageQueue.erase(cancelledMessage);
+					cancelled = true;
+				}
+			}
+			// Requests already being processed are not interrupted.
+			if (cancelled)
+				m_client.error(cancelledID, ErrorCode::RequestCancelled, "Request cancelled.");
+			continue;
+		}
+
+		{
+			std::lock_guard lock(m_messageQueueMutex);
+			m_messageQueue.emplace_back(std::move(*jsonMessage));
+		}
+		m_messageQueueCondition.notify_one();
+
+		// Nothing is read after the exit notification, the client might not close the input.
+		if (methodName == "exit")
+			return;
+	}
+
+	{
+		std::lock_guard lock(m_messageQueueMutex);
+		m_inputClosed = true;
+	}
+	m_messageQueueCondition.notify_one();
+}
+
+std::optional<Json> LanguageServer::nextMessage()
+{
+	std::unique_lock lock(m_messageQueueMutex);
+	auto const messageAvailable = [this]() { return !m_messageQueue.empty() || m_inputClosed; };
+	if (m_scheduledCompilation)
+		m_messageQueueCondition.wait_until(lock, *m_scheduledCompilation, messageAvailable);
+	else
+		m_messageQueueCondition.wait(lock, messageAvailable);
+
+	if (m_messageQueue.empty())
+		return std::nullopt;
+	Json jsonMessage = std::move(m_messageQueue.front());
+	m_messageQueue.pop_front();
+	return jsonMessage;
+}
+
 void LanguageServer::requireServerInitialized()
 {
 	lspRequire(
@@ -432,7 +671,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		compileAndUpdateDiagnostics();
+		scheduleCompileAndUpdateDiagnostics();
 }
 
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
@@ -441,9 +680,11 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 	{
 		auto uri = _args["textDocument"]["uri"];
 
-		compile();
-
 		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
+		// Pending changes are not compiled, the tokens are those of the last analysis.
+		if (!util::contains(m_compilerStack.sourceNames(), sourceName))
+			compile({sourceName});
+
 		SourceUnit const& ast = m_compilerStack.ast(sourceName);
 		m_compilerStack.charStream(sourceName);
 		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
@@ -496,7 +737,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
-		compileAndUpdateDiagnostics();
+		scheduleCompileAndUpdateDiagnostics();
 	}
 }
 
@@ -543,7 +784,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		scheduleCompileAndUpdateDiagnostics();
 	}
 }
 
@@ -562,7 +803,7 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
 
-		compileAndUpdateDiagnostics();
+		scheduleCompileAndUpdateDiagnostics();
 	}
 }
 
@@ -573,10 +814,12 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
-		return {nullptr, -1};
 	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
+	if (!util::contains(m_compilerStack.sourceNames(), _sourceUnitName))
+		compile({_sourceUnitName});
+	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+		return {nullptr, -1};
 
 	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
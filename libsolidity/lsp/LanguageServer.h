@@ -24,9 +24,14 @@
 
 #include <libsolutil/JSON.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -57,6 +62,16 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Messages are received on a separate thread, but they are processed and the sources are
+ * analyzed on the thread calling @a run. Analysis cannot move to a worker thread while
+ * requests are answered from the AST of an earlier analysis: the types referenced by the
+ * annotations of an AST are owned by the global TypeProvider, which is reset by every analysis.
+ * Instead, changes are only analyzed after a short pause and queued requests can be cancelled.
+ * Hover and semantic tokens requests are answered from the AST of the last analysis without
+ * waiting for pending changes, which is the analysis whose diagnostics were published last.
+ * Other requests reading the analysis first analyze the pending changes. A compilation in
+ * progress is not interrupted.
  */
 class LanguageServer
 {
@@ -67,7 +82,13 @@ public:
 	/// Re-compiles the project and updates the diagnostics pushed to the client.
 	void compileAndUpdateDiagnostics();
 
+	/// Re-compiles the project and updates the diagnostics once no further message arrived
+	/// for a short time, so that a burst of changes only causes a single compilation.
+	void scheduleCompileAndUpdateDiagnostics();
+
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
+	/// Messages are received on a separate thread, so that changes and cancellations arriving
+	/// during a compilation are known as soon as it is finished.
 	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
 	/// has been exceeded.
@@ -81,6 +102,10 @@ public:
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
 
+	/// Makes sure that all of @a _sourceUnitNames are analyzed by the compiler stack,
+	/// re-analyzing the affected source units if necessary.
+	void requireAnalysis(std::set<std::string> const& _sourceUnitNames);
+
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
@@ -96,11 +121,29 @@ private:
 	void handleGotoDefinition(MessageID _id, Json const& _args);
 	void semanticTokensFull(MessageID _id, Json const& _args);
 
+	/// Receives messages from the client and queues them until the input is closed or
+	/// the exit notification was received. Cancelled requests that are still queued
+	/// are removed from the queue and answered right away.
+	void receiveMessages();
+	/// @returns the next queued message, or nullopt if the input is closed or the scheduled
+	/// compilation is due before a message arrives.
+	std::optional<Json> nextMessage();
+
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	/// Compiles until after analysis phase all source units that changed since they were last
+	/// analyzed, all source units importing them and all of @a _requiredSourceUnits.
+	/// Does nothing if there are no such source units or they are already in the compiler stack.
+	void compile(std::set<std::string> const& _requiredSourceUnits = {});
+
+	/// @returns true if the source unit has been analyzed completely in its current version.
+	bool analyzedAndUnchanged(std::string const& _sourceUnitName) const;
+	/// @returns the source units that were added, removed or changed since their last analysis,
+	/// together with all the source units importing them directly or indirectly.
+	std::set<std::string> affectedSourceUnits() const;
+	/// Stores the diagnostics and imports of all source units in the compiler stack.
+	void recordAnalysis();
 
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
@@ -117,6 +160,15 @@ private:
 	Transport& m_client;
 	std::map<std::string, MessageHandler> m_handlers;
 
+	/// Messages received but not processed yet, guarded by m_messageQueueMutex.
+	std::deque<Json> m_messageQueue;
+	bool m_inputClosed = false;
+	std::mutex m_messageQueueMutex;
+	std::condition_variable m_messageQueueCondition;
+
+	/// Time at which the next compilation is due, if one is scheduled.
+	std::optional<std::chrono::steady_clock::time_point> m_scheduledCompilation;
+
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
 	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
@@ -126,6 +178,20 @@ private:
 
 	frontend::CompilerStack m_compilerStack;
 
+	/// State of a source unit as of the last analysis that included it.
+	struct AnalyzedSourceUnit
+	{
+		/// Content of the source unit when it was analyzed, or nullopt if the analysis
+		/// was cut short by errors in other source units.
+		std::optional<std::string> content;
+		/// Source unit names of the direct imports.
+		std::set<std::string> imports;
+		Json diagnostics = Json::array();
+	};
+	/// Source units that have been analyzed before, by source unit name. Only the source units
+	/// affected by a change are re-analyzed, all others keep their diagnostics.
+	std::map<std::string, AnalyzedSourceUnit> m_analyzedSourceUnits;
+
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
 };
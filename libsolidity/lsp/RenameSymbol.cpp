@@ -22,7 +22,10 @@
 
 #include <fmt/format.h>
 
+#include <range/v3/view/map.hpp>
+
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -53,6 +56,9 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	std::string const newName = _args["newName"].get<std::string>();
 	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
 
+	// The symbol can be referenced from any source unit, so all of them have to be analyzed.
+	m_server.requireAnalysis(util::convertContainer<std::set<std::string>>(fileRepository().sourceUnits() | ranges::views::keys));
+
 	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
 
 	m_symbolName = {};
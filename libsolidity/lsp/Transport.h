@@ -23,6 +23,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -50,6 +51,7 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
+	RequestCancelled = -32800,
 	RequestFailed = -32803
 };
 
@@ -91,6 +93,8 @@ private:
  *
  * The transport layer API is abstracted to make LSP more testable as well as
  * this way it could be possible to support other transports (HTTP for example) easily.
+ *
+ * Messages may be sent from a different thread than the one receiving messages.
  */
 class Transport
 {
@@ -111,6 +115,8 @@ public:
 
 private:
 	TraceValue m_logTrace = TraceValue::Off;
+	/// Serializes sending of whole messages.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
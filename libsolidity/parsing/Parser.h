@@ -27,6 +27,8 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Arena.h>
+
 namespace solidity::langutil
 {
 class CharStream;
@@ -50,6 +52,10 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+	/// Adds @a _offset to the IDs of all nodes created by this parser and to the next ID, as if the
+	/// parser had started counting at @a _offset. This allows sources parsed by separate parsers to
+	/// be numbered as if they were parsed one after another by the same parser.
+	void shiftIDs(int64_t _offset);
 private:
 	class ASTNodeFactory;
 
@@ -213,6 +219,23 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Creates a node in the arena of the current source unit. Every node keeps the arena alive.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> createNode(Args&& ... _args)
+	{
+		return registerNode(std::allocate_shared<NodeType>(
+			util::ArenaAllocator<NodeType>(m_arena),
+			nextID(),
+			std::forward<Args>(_args)...
+		));
+	}
+	/// Registers a node created by this parser, so that its ID can be shifted later.
+	template <class NodeType>
+	ASTPointer<NodeType> registerNode(ASTPointer<NodeType> _node)
+	{
+		m_nodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -249,6 +272,11 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory of the nodes of the source unit being parsed. It is released once all of them are destroyed.
+	std::shared_ptr<util::Arena> m_arena;
+	/// All nodes created by this parser. Nodes can be dropped while parsing, e.g. when
+	/// an expression turns out to be a type name, so they are not kept alive.
+	std::vector<std::weak_ptr<ASTNode>> m_nodes;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Per-thread count of heap allocations.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace solidity::util
+{
+
+/**
+ * Counts the heap allocations of each thread.
+ *
+ * The allocations are not counted by the libraries themselves. An executable that wants
+ * them to be counted replaces the global `operator new` by one that calls @a count
+ * and calls @a enable at startup (like solc does if built with COUNT_ALLOCATIONS).
+ */
+class AllocationCounter
+{
+public:
+	static void count() noexcept { ++t_allocations; }
+	static void enable() noexcept { s_enabled = true; }
+
+	/// @returns true if the executable counts allocations.
+	static bool enabled() noexcept { return s_enabled; }
+	/// @returns the number of allocations made by the current thread so far.
+	static size_t allocations() noexcept { return t_allocations; }
+
+private:
+	static inline thread_local size_t t_allocations = 0;
+	static inline bool s_enabled = false;
+};
+
+}
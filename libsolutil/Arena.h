@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump allocator for many small objects that are released together.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Memory that is handed out in increasing addresses from large blocks and only released
+/// as a whole when the arena is destroyed. Not thread-safe.
+class Arena
+{
+public:
+	Arena() = default;
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns @a _size bytes aligned to @a _alignment, which has to be a power of two.
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		size_t padding = (_alignment - reinterpret_cast<uintptr_t>(m_next) % _alignment) % _alignment;
+		if (!m_next || padding + _size > m_remaining)
+		{
+			size_t blockSize = std::max(c_blockSize, _size + _alignment);
+			m_blocks.emplace_back(std::make_unique<std::byte[]>(blockSize));
+			m_next = m_blocks.back().get();
+			m_remaining = blockSize;
+			padding = (_alignment - reinterpret_cast<uintptr_t>(m_next) % _alignment) % _alignment;
+		}
+		std::byte* result = m_next + padding;
+		m_next = result + _size;
+		m_remaining -= padding + _size;
+		return result;
+	}
+
+private:
+	static size_t constexpr c_blockSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	std::byte* m_next = nullptr;
+	size_t m_remaining = 0;
+};
+
+/// Allocator using an arena that is kept alive by every copy of the allocator. Deallocation does
+/// nothing, the memory is released together with the arena. Objects created with
+/// `std::allocate_shared` store a copy in their control block, so the arena lives as long as any
+/// of them, including weak pointers. The destructors of the objects still run as usual, since
+/// they may own memory outside of the arena.
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <typename U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <typename U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -26,6 +26,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <ostream>
 #include <sstream>
 
 #ifdef STRICT_NLOHMANN_JSON_VERSION_CHECK
@@ -144,6 +145,150 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+JsonWriter::JsonWriter(std::ostream& _stream, JsonFormat const& _format):
+	m_stream(&_stream),
+	m_format(_format),
+	m_levels(1)
+{
+}
+
+JsonWriter::JsonWriter(Json& _document):
+	m_document(&_document),
+	m_levels(1)
+{
+}
+
+void JsonWriter::beginObject(std::string _key, bool _keepIfEmpty)
+{
+	m_levels.push_back({std::move(_key)});
+	if (!_keepIfEmpty)
+		return;
+	if (m_stream)
+		printOpenObjects();
+	else
+		documentObject();
+}
+
+void JsonWriter::endObject()
+{
+	if (m_stream)
+		printClose(m_levels.size() - 1);
+	m_levels.pop_back();
+}
+
+void JsonWriter::write(std::string const& _key, Json const& _value)
+{
+	if (m_stream)
+		print(_key, _value);
+	else
+		documentObject()[_key] = _value;
+}
+
+void JsonWriter::write(std::string const& _key, Json&& _value)
+{
+	if (m_stream)
+		print(_key, _value);
+	else
+		documentObject()[_key] = std::move(_value);
+}
+
+void JsonWriter::writeMembers(Json&& _object)
+{
+	for (auto& [key, value]: _object.items())
+		write(key, std::move(value));
+}
+
+bool JsonWriter::hasMember(std::string const& _key) const
+{
+	if (m_stream)
+		return m_printedMembers.count(_key) > 0;
+	return m_document->is_object() && m_document->contains(_key);
+}
+
+void JsonWriter::discard()
+{
+	while (m_levels.size() > 1)
+		endObject();
+	if (m_document)
+		*m_document = Json::object();
+}
+
+void JsonWriter::finish()
+{
+	while (m_levels.size() > 1)
+		endObject();
+	if (m_stream)
+	{
+		printOpenObjects();
+		printClose(0);
+	}
+	else
+		documentObject();
+	m_levels.clear();
+}
+
+void JsonWriter::print(std::string const& _key, Json const& _value)
+{
+	bool const pretty = m_format.format == JsonFormat::Pretty;
+	// Serialized before anything is printed so that a failure does not leave half a member behind.
+	std::string value = _value.dump(pretty ? static_cast<int>(m_format.indent) : -1, ' ', true);
+	if (pretty)
+		// Line breaks only occur between tokens, the ones inside strings are escaped.
+		boost::replace_all(value, "\n", "\n" + std::string(m_format.indent * m_levels.size(), ' '));
+	printOpenObjects();
+	printKey(m_levels.size() - 1, _key);
+	*m_stream << value;
+}
+
+void JsonWriter::printOpenObjects()
+{
+	for (size_t depth = 0; depth < m_levels.size(); ++depth)
+		if (!m_levels[depth].printed)
+		{
+			if (depth > 0)
+				printKey(depth - 1, m_levels[depth].key);
+			*m_stream << '{';
+			m_levels[depth].printed = true;
+		}
+}
+
+void JsonWriter::printKey(size_t _depth, std::string const& _key)
+{
+	bool const pretty = m_format.format == JsonFormat::Pretty;
+	if (m_levels[_depth].hasMembers)
+		*m_stream << ',';
+	m_levels[_depth].hasMembers = true;
+	if (_depth == 0)
+		m_printedMembers.insert(_key);
+	if (pretty)
+		*m_stream << '\n' << std::string(m_format.indent * (_depth + 1), ' ');
+	*m_stream << Json(_key).dump(-1, ' ', true) << (pretty ? ": " : ":");
+}
+
+void JsonWriter::printClose(size_t _depth)
+{
+	if (!m_levels[_depth].printed)
+		return;
+	if (m_levels[_depth].hasMembers && m_format.format == JsonFormat::Pretty)
+		*m_stream << '\n' << std::string(m_format.indent * _depth, ' ');
+	*m_stream << '}';
+}
+
+Json& JsonWriter::documentObject()
+{
+	Json* object = m_document;
+	if (!object->is_object())
+		*object = Json::object();
+	for (size_t depth = 1; depth < m_levels.size(); ++depth)
+	{
+		Json& member = (*object)[m_levels[depth].key];
+		if (!member.is_object())
+			member = Json::object();
+		object = &member;
+	}
+	return *object;
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
@@ -26,10 +26,13 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <iosfwd>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <set>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +74,65 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/// Writes a JSON object member by member, either to a stream or into a JSON document, so that a
+/// large output does not have to be held in memory as a whole before it is printed.
+/// Members have to be added sorted by key for the printed output to be identical to what
+/// @a jsonPrint prints for the corresponding document. Objects opened with @a beginObject
+/// are only printed once they get their first member, i.e. empty ones are left out.
+class JsonWriter
+{
+public:
+	/// Creates a writer that prints to @a _stream in format @a _format.
+	JsonWriter(std::ostream& _stream, JsonFormat const& _format);
+	/// Creates a writer that stores the members in @a _document.
+	explicit JsonWriter(Json& _document);
+
+	/// Opens an object as member @a _key of the innermost open object. Unless @a _keepIfEmpty
+	/// is set, the object is left out if it does not get any members before it is closed.
+	void beginObject(std::string _key, bool _keepIfEmpty = false);
+	/// Closes the innermost object opened with @a beginObject.
+	void endObject();
+	/// Adds member @a _key with value @a _value to the innermost open object.
+	void write(std::string const& _key, Json const& _value);
+	void write(std::string const& _key, Json&& _value);
+	/// Adds all members of the object @a _object to the innermost open object.
+	void writeMembers(Json&& _object);
+	/// @returns true if the outermost object has a member @a _key, i.e. it has been written and,
+	/// when printing to a stream, printed.
+	bool hasMember(std::string const& _key) const;
+	/// Closes all objects opened with @a beginObject and removes the members written so far
+	/// from the document. Members that have already been printed to a stream cannot be taken back.
+	void discard();
+	/// Closes all open objects including the outermost one, which is printed even if it is empty.
+	void finish();
+
+private:
+	struct Level
+	{
+		std::string key;
+		bool printed = false;
+		bool hasMembers = false;
+	};
+
+	/// Prints member @a _key with value @a _value of the innermost open object.
+	void print(std::string const& _key, Json const& _value);
+	/// Prints the opening braces of all open objects that have not been printed yet.
+	void printOpenObjects();
+	/// Prints the separator and the key of a new member of the object at @a _depth.
+	void printKey(size_t _depth, std::string const& _key);
+	/// Prints the closing brace of the object at @a _depth if it was printed.
+	void printClose(size_t _depth);
+	/// @returns the innermost open object of the document, creating the enclosing ones as needed.
+	Json& documentObject();
+
+	std::ostream* m_stream = nullptr;
+	Json* m_document = nullptr;
+	JsonFormat m_format;
+	std::vector<Level> m_levels;
+	/// Keys of the members of the outermost object printed so far.
+	std::set<std::string> m_printedMembers;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
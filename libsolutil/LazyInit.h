@@ -33,7 +33,7 @@ DEV_SIMPLE_EXCEPTION(BadLazyInitAccess);
 
 /**
  * A value that is initialized at some point after construction of the LazyInit. The stored value can only be accessed
- * while calling "init", which initializes the stored value (if it has not already been initialized).
+ * while calling "init", which initializes the stored value (if it has not already been initialized), or "valueOrCompute".
  *
  * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
  */
@@ -79,6 +79,16 @@ public:
 		return m_value.value();
 	}
 
+	/// @returns a copy of the stored value if it has been initialized and the result of @a _fun
+	/// otherwise. Unlike @a init, this does not store the result.
+	template<typename F>
+	std::remove_const_t<value_type> valueOrCompute(F&& _fun) const
+	{
+		if (m_value.has_value())
+			return m_value.value();
+		return std::forward<F>(_fun)();
+	}
+
 private:
 	/// Although not quite logically const, this is marked const for pragmatic reasons. It doesn't change the platonic
 	/// value of the object (which is something that is initialized to some computed value on first use).
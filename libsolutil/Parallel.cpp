@@ -0,0 +1,159 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Threads that run the functions posted to them. Threads are added when they are needed
+/// and only stopped at the end of the program.
+class ThreadPool
+{
+public:
+	static ThreadPool& instance()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopped = true;
+		}
+		m_wakeUp.notify_all();
+		for (std::thread& thread: m_threads)
+			thread.join();
+	}
+
+	/// Queues @a _count calls of @a _function, making sure there are at least @a _count threads.
+	void post(std::function<void()> const& _function, size_t _count)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			// Threads are created before anything is queued, so that nothing remains queued
+			// if creating a thread fails.
+			while (m_threads.size() < _count)
+				m_threads.emplace_back([this] { work(); });
+			for (size_t i = 0; i < _count; ++i)
+				m_queue.push_back(_function);
+		}
+		m_wakeUp.notify_all();
+	}
+
+private:
+	ThreadPool() = default;
+
+	void work()
+	{
+		std::unique_lock lock(m_mutex);
+		while (true)
+		{
+			m_wakeUp.wait(lock, [&] { return m_stopped || !m_queue.empty(); });
+			if (m_queue.empty())
+				return;
+			std::function<void()> function = std::move(m_queue.front());
+			m_queue.pop_front();
+			lock.unlock();
+			function();
+			lock.lock();
+		}
+	}
+
+	/// Protects the members below.
+	std::mutex m_mutex;
+	std::condition_variable m_wakeUp;
+	std::deque<std::function<void()>> m_queue;
+	std::vector<std::thread> m_threads;
+	bool m_stopped = false;
+};
+
+}
+
+void solidity::util::parallelFor(size_t _count, size_t _jobs, std::function<void(size_t)> const& _task)
+{
+#ifdef __EMSCRIPTEN__
+	_jobs = 1;
+#endif
+	if (_jobs <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	// Shared with the posted functions, since they may only start running after all tasks
+	// have been done by other threads and this function has returned.
+	struct State
+	{
+		std::atomic<size_t> nextIndex{0};
+		std::mutex mutex;
+		std::condition_variable finished;
+		size_t finishedCount = 0;
+		std::vector<std::exception_ptr> exceptions;
+	};
+	auto state = std::make_shared<State>();
+	state->exceptions.resize(_count);
+
+	// The task is only accessed for indices that have not been started yet, i.e. while
+	// this function is still waiting for them.
+	std::function<void(size_t)> const* task = &_task;
+	auto worker = [state, task, _count]()
+	{
+		for (size_t i = state->nextIndex++; i < _count; i = state->nextIndex++)
+		{
+			try
+			{
+				(*task)(i);
+			}
+			catch (...)
+			{
+				state->exceptions[i] = std::current_exception();
+			}
+			std::lock_guard lock(state->mutex);
+			if (++state->finishedCount == _count)
+				state->finished.notify_all();
+		}
+	};
+
+	ThreadPool::instance().post(worker, std::min(_jobs, _count) - 1);
+	worker();
+	{
+		std::unique_lock lock(state->mutex);
+		state->finished.wait(lock, [&] { return state->finishedCount == _count; });
+	}
+
+	for (std::exception_ptr const& exception: state->exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
@@ -0,0 +1,43 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent tasks on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _task(i) for every i in [0, _count), using up to @a _jobs threads including the calling one.
+/// The tasks have to be independent of each other, since the order in which they run is unspecified.
+/// The other threads are taken from a pool that is shared by all calls and lives until the end of
+/// the program, so that thread-local state like the tables of optimiser rules is built only once
+/// per thread. The calling thread takes part in the work and only waits for tasks that have
+/// already been started, so nested calls cannot deadlock even if all threads of the pool are busy.
+/// If tasks throw, the remaining tasks are still run and afterwards the exception of the task
+/// with the smallest index is rethrown, so that the reported error does not depend on scheduling.
+/// If @a _jobs is at most one, the tasks are run in order on the calling thread and
+/// the first exception is propagated immediately. The JavaScript build has no threads
+/// and always runs the tasks like this.
+void parallelFor(size_t _count, size_t _jobs, std::function<void(size_t)> const& _task);
+
+}
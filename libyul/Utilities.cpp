@@ -90,8 +90,15 @@ u256 solidity::yul::valueOfNumberLiteral(Literal const& _literal)
 {
 	yulAssert(_literal.kind == LiteralKind::Number, "Expected number literal!");
 
-	static std::map<YulString, u256> numberCache;
-	static YulStringRepository::ResetCallback callback{[&] { numberCache.clear(); }};
+	// The cache is per thread, so that it can be used without locking. Threads outlive resets of
+	// the YulStringRepository, so the cache is cleared when it is used after a reset.
+	thread_local std::map<YulString, u256> numberCache;
+	thread_local size_t numberCacheGeneration = 0;
+	if (numberCacheGeneration != YulStringRepository::generation())
+	{
+		numberCache.clear();
+		numberCacheGeneration = YulStringRepository::generation();
+	}
 
 	auto&& [it, isNew] = numberCache.try_emplace(_literal.value, 0);
 	if (isNew)
@@ -30,6 +30,7 @@
 #include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
 #include <libevmasm/Assembly.h>
@@ -61,6 +62,23 @@ Dialect const& languageToDialect(YulStack::Language _language, EVMVersion _versi
 	return Dialect::yulDeprecated();
 }
 
+/// @returns a deep copy of the code and subobjects of @a _object without analysis information,
+/// so that it can be modified and analyzed independently of the original.
+std::shared_ptr<Object> copyObject(Object const& _object)
+{
+	auto copy = std::make_shared<Object>();
+	copy->name = _object.name;
+	copy->code = std::make_shared<Block>(std::get<Block>(ASTCopier{}(*_object.code)));
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			copy->subObjects.emplace_back(copyObject(*subObject));
+		else
+			copy->subObjects.emplace_back(subNode);
+	copy->subIndexByName = _object.subIndexByName;
+	copy->debugData = _object.debugData;
+	return copy;
+}
+
 }
 
 
@@ -86,7 +104,11 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(
+	std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects,
+	size_t _jobs,
+	OptimiserProfile* _profile
+)
 {
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -99,7 +121,7 @@ void YulStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	optimize(*m_parserResult, true, _optimizedSubObjects, _jobs, _profile);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -150,15 +172,28 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+void YulStack::optimize(
+	Object& _object,
+	bool _isCreation,
+	std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects,
+	size_t _jobs,
+	OptimiserProfile* _profile
+)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
+			if (auto optimizedSubObject = _optimizedSubObjects.find(subObject->name); optimizedSubObject != _optimizedSubObjects.end())
+			{
+				yulAssert(optimizedSubObject->second && optimizedSubObject->second->analysisInfo, "");
+				// The object is copied, since the original can be used by other compilations concurrently.
+				subNode = copyObject(*optimizedSubObject->second);
+				continue;
+			}
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
+			optimize(*subObject, isCreation, _optimizedSubObjects, _jobs, _profile);
 		}
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
@@ -200,7 +235,9 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		yulOptimiserSteps,
 		yulOptimiserCleanupSteps,
 		_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		_jobs,
+		_profile
 	);
 }
 
@@ -255,7 +292,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName) cons
 }
 
 std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
-YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName) const
+YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName, size_t _jobs) const
 {
 	yulAssert(m_analysisSuccessful, "");
 	yulAssert(m_parserResult, "");
@@ -274,7 +311,7 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName) c
 	);
 	compileEVM(adapter, optimize);
 
-	assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+	assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion, _jobs));
 
 	std::optional<size_t> subIndex;
 
@@ -34,6 +34,7 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -50,6 +51,7 @@ class Scanner;
 namespace solidity::yul
 {
 class AbstractAssembly;
+class OptimiserProfile;
 
 
 struct MachineAssemblyObject
@@ -102,7 +104,16 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// Subobjects named like a key of @a _optimizedSubObjects are not optimized again, but replaced
+	/// by a copy of the given object, which has to be the result of optimizing the same code with
+	/// the same settings. The given objects are not modified.
+	/// Independent functions are optimized using up to @a _jobs threads.
+	/// If @a _profile is given, the optimiser steps run on each object are recorded in it.
+	void optimize(
+		std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects = {},
+		size_t _jobs = 1,
+		OptimiserProfile* _profile = nullptr
+	);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine) const;
@@ -118,10 +129,12 @@ public:
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// Similar to @a assemblyWithDeployed, but returns EVM assembly objects.
+	/// Independent sub-assemblies are optimised using up to @a _jobs threads.
 	/// Only available for EVM.
 	std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
 	assembleEVMWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		size_t _jobs = 1
 	) const;
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
@@ -141,7 +154,13 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	void optimize(
+		yul::Object& _object,
+		bool _isCreation,
+		std::map<YulString, std::shared_ptr<Object const>> const& _optimizedSubObjects,
+		size_t _jobs,
+		OptimiserProfile* _profile
+	);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
@@ -0,0 +1,142 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <stdexcept>
+
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Mixes the bits of a string hash for use in the hash table. The low bits of the
+/// FNV hash mostly depend on the last character of the string.
+std::uint64_t mix(std::uint64_t _hash)
+{
+	_hash ^= _hash >> 33;
+	_hash *= 0xff51afd7ed558ccdu;
+	_hash ^= _hash >> 33;
+	_hash *= 0xc4ceb9fe1a85ec53u;
+	_hash ^= _hash >> 33;
+	return _hash;
+}
+
+}
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& block: m_blocks)
+		delete[] block.load();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(std::string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	std::uint64_t h = hash(_string);
+	Shard& shard = m_shards[mix(h) % shardCount];
+	{
+		std::shared_lock lock(shard.mutex);
+		if (std::optional<size_t> id = findID(shard, _string, h))
+			return Handle{*id, h};
+	}
+
+	std::unique_lock lock(shard.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (std::optional<size_t> id = findID(shard, _string, h))
+		return Handle{*id, h};
+
+	if (2 * (shard.size + 1) > shard.slots.size())
+	{
+		std::vector<Shard::Slot> slots(2 * shard.slots.size());
+		for (Shard::Slot const& slot: shard.slots)
+			if (slot.id != 0)
+			{
+				size_t index = (mix(slot.hash) / shardCount) & (slots.size() - 1);
+				while (slots[index].id != 0)
+					index = (index + 1) & (slots.size() - 1);
+				slots[index] = slot;
+			}
+		shard.slots = std::move(slots);
+	}
+
+	size_t id = storeString(_string);
+	size_t index = (mix(h) / shardCount) & (shard.slots.size() - 1);
+	while (shard.slots[index].id != 0)
+		index = (index + 1) & (shard.slots.size() - 1);
+	shard.slots[index] = {h, id};
+	++shard.size;
+
+	return Handle{id, h};
+}
+
+std::optional<size_t> YulStringRepository::findID(Shard const& _shard, std::string const& _string, std::uint64_t _hash) const
+{
+	for (
+		size_t index = (mix(_hash) / shardCount) & (_shard.slots.size() - 1);
+		_shard.slots[index].id != 0;
+		index = (index + 1) & (_shard.slots.size() - 1)
+	)
+		if (_shard.slots[index].hash == _hash && idToString(_shard.slots[index].id) == _string)
+			return _shard.slots[index].id;
+	return std::nullopt;
+}
+
+size_t YulStringRepository::storeString(std::string const& _string)
+{
+	size_t id = m_nextID.fetch_add(1, std::memory_order_relaxed);
+	size_t blockIndex = id / blockSize;
+	if (blockIndex >= maxBlocks)
+		throw std::length_error("Too many distinct Yul strings.");
+
+	std::string* block = m_blocks[blockIndex].load(std::memory_order_acquire);
+	if (!block)
+	{
+		std::lock_guard lock(m_blocksMutex);
+		block = m_blocks[blockIndex].load(std::memory_order_relaxed);
+		if (!block)
+		{
+			block = new std::string[blockSize];
+			m_blocks[blockIndex].store(block, std::memory_order_release);
+		}
+	}
+	block[id % blockSize] = _string;
+	return id;
+}
+
+void YulStringRepository::clear()
+{
+	for (auto& block: m_blocks)
+		delete[] block.exchange(nullptr);
+	// The first block holds the empty string with ID zero.
+	m_blocks[0] = new std::string[blockSize];
+	m_nextID = 1;
+
+	for (Shard& shard: m_shards)
+	{
+		std::unique_lock lock(shard.mutex);
+		shard.slots = std::vector<Shard::Slot>(16);
+		shard.size = 0;
+	}
+}
@@ -23,8 +23,13 @@
 
 #include <fmt/format.h>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +41,10 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository can be used from multiple threads concurrently: Strings are looked up by ID
+/// without locking and the hash table is split into shards that are locked independently.
+/// The string objects are stored in large blocks, but since YulString::str() hands out references
+/// to std::string, strings longer than the small string buffer still own a separate allocation.
 class YulStringRepository
 {
 public:
@@ -51,26 +60,19 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	~YulStringRepository();
+
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		std::string const* block = m_blocks[_id / blockSize].load(std::memory_order_acquire);
+		return block[_id % blockSize];
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. It determines the order of YulStrings and thereby the order in which
+		// the optimiser visits names, so replacing it changes the generated code.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -87,35 +89,86 @@ public:
 	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		{
+			std::lock_guard lock(resetCallbacksMutex());
+			for (auto const& cb: resetCallbacks())
+				cb();
+		}
+		instance().clear();
+		++generationCounter();
 	}
+	/// @returns the number of times the repository has been reset. Lets caches that are
+	/// local to a thread notice that the strings they refer to are gone.
+	static size_t generation() { return generationCounter().load(std::memory_order_acquire); }
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard lock(YulStringRepository::resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Number of strings per block of the string storage.
+	static size_t constexpr blockSize = 4096;
+	/// Maximum number of blocks, limiting the number of strings to about 67 million.
+	static size_t constexpr maxBlocks = 16384;
+	static size_t constexpr shardCount = 64;
+
+	/// Part of the hash table, containing the strings whose hashes map to it.
+	struct Shard
+	{
+		struct Slot
+		{
+			std::uint64_t hash = 0;
+			/// Zero denotes an empty slot, since the empty string is never stored in a shard.
+			size_t id = 0;
+		};
+		/// Protects the members below.
+		mutable std::shared_mutex mutex;
+		/// Open addressing hash table with linear probing. Its size is a power of two.
+		std::vector<Slot> slots = std::vector<Slot>(16);
+		size_t size = 0;
+	};
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+	static std::atomic<size_t>& generationCounter()
+	{
+		static std::atomic<size_t> counter{0};
+		return counter;
+	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// @returns the ID of @a _string with hash @a _hash, if it is already stored in @a _shard.
+	/// Requires the mutex of @a _shard to be held.
+	std::optional<size_t> findID(Shard const& _shard, std::string const& _string, std::uint64_t _hash) const;
+	/// Stores @a _string and @returns its new ID.
+	size_t storeString(std::string const& _string);
+
+	void clear();
+
+	/// Strings by ID, in blocks of @a blockSize strings. Blocks are never moved, so strings can be
+	/// read without locking. A string is stored before its ID is published in a shard.
+	std::array<std::atomic<std::string*>, maxBlocks> m_blocks{};
+	std::atomic<size_t> m_nextID{1};
+	/// Protects the allocation of blocks.
+	std::mutex m_blocksMutex;
+	std::array<Shard, shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
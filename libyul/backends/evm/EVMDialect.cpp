@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std::string_literals;
@@ -394,7 +395,12 @@ bool EVMDialect::reservedIdentifier(YulString _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		std::lock_guard lock(mutex);
+		dialects.clear();
+	}};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -403,7 +409,12 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
 	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		std::lock_guard lock(mutex);
+		dialects.clear();
+	}};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
@@ -432,6 +443,7 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	std::pair<size_t, size_t> key{_arguments, _returnVariables};
+	std::lock_guard lock(m_verbatimFunctionsMutex);
 	std::shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -559,7 +571,12 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static std::map<langutil::EVMVersion, std::unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		std::lock_guard lock(mutex);
+		dialects.clear();
+	}};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
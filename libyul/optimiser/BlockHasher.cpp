@@ -225,3 +225,152 @@ void ExpressionHasher::operator()(FunctionCall const& _funCall)
 	hash64(_funCall.arguments.size());
 	ASTWalker::operator()(_funCall);
 }
+
+std::vector<uint64_t> StatementHasher::run(Block const& _block)
+{
+	std::vector<uint64_t> hashes;
+	hashes.reserve(_block.statements.size() + 1);
+	for (auto const& statement: _block.statements)
+		hashes.emplace_back(hash(statement));
+	StatementHasher blockHasher;
+	blockHasher.hashDebugData(_block.debugData);
+	hashes.emplace_back(blockHasher.m_hash);
+	return hashes;
+}
+
+uint64_t StatementHasher::hash(Statement const& _statement)
+{
+	StatementHasher statementHasher;
+	statementHasher.visit(_statement);
+	return statementHasher.m_hash;
+}
+
+void StatementHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	hashDebugData(_literal.debugData);
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void StatementHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hashDebugData(_identifier.debugData);
+	hash64(_identifier.name.hash());
+}
+
+void StatementHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hashDebugData(_funCall.debugData);
+	(*this)(_funCall.functionName);
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void StatementHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(compileTimeLiteralHash("ExpressionStatement"));
+	hashDebugData(_statement.debugData);
+	ASTWalker::operator()(_statement);
+}
+
+void StatementHasher::operator()(Assignment const& _assignment)
+{
+	hash64(compileTimeLiteralHash("Assignment"));
+	hashDebugData(_assignment.debugData);
+	hash64(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void StatementHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(compileTimeLiteralHash("VariableDeclaration"));
+	hashDebugData(_varDecl.debugData);
+	hashTypedNames(_varDecl.variables);
+	hash8(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void StatementHasher::operator()(If const& _if)
+{
+	hash64(compileTimeLiteralHash("If"));
+	hashDebugData(_if.debugData);
+	ASTWalker::operator()(_if);
+}
+
+void StatementHasher::operator()(Switch const& _switch)
+{
+	hash64(compileTimeLiteralHash("Switch"));
+	hashDebugData(_switch.debugData);
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	// Unlike in the BlockHasher, the order of the cases matters here.
+	for (auto const& _case: _switch.cases)
+	{
+		hash64(compileTimeLiteralHash("Case"));
+		hashDebugData(_case.debugData);
+		hash8(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void StatementHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hashDebugData(_funDef.debugData);
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	(*this)(_funDef.body);
+}
+
+void StatementHasher::operator()(ForLoop const& _loop)
+{
+	hash64(compileTimeLiteralHash("ForLoop"));
+	hashDebugData(_loop.debugData);
+	ASTWalker::operator()(_loop);
+}
+
+void StatementHasher::operator()(Break const& _break)
+{
+	hash64(compileTimeLiteralHash("Break"));
+	hashDebugData(_break.debugData);
+}
+
+void StatementHasher::operator()(Continue const& _continue)
+{
+	hash64(compileTimeLiteralHash("Continue"));
+	hashDebugData(_continue.debugData);
+}
+
+void StatementHasher::operator()(Leave const& _leaveStatement)
+{
+	hash64(compileTimeLiteralHash("Leave"));
+	hashDebugData(_leaveStatement.debugData);
+}
+
+void StatementHasher::operator()(Block const& _block)
+{
+	hash64(compileTimeLiteralHash("Block"));
+	hashDebugData(_block.debugData);
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void StatementHasher::hashTypedNames(std::vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hashDebugData(name.debugData);
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
@@ -24,6 +24,8 @@
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
 
+#include <liblangutil/DebugData.h>
+
 namespace solidity::yul
 {
 
@@ -54,6 +56,10 @@ protected:
 		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
 		hash32(static_cast<uint32_t>(_value >> 32));
 	}
+	void hashPointer(void const* _pointer)
+	{
+		hash64(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(_pointer)));
+	}
 
 
 	uint64_t m_hash = fnvEmptyHash;
@@ -142,4 +148,45 @@ struct ExpressionHash
 	}
 };
 
+/**
+ * Computes one hash value per top-level statement of a block (i.e. per function and
+ * per code block if the block is grouped), meant to detect whether an optimiser step
+ * changed the AST.
+ *
+ * In contrast to the BlockHasher and the ExpressionHasher, the hashes take everything
+ * into account that an optimiser step could depend on: names of variables and functions,
+ * literals as written and the identity of the debug data attached to the nodes.
+ * Identical statements have identical hashes and statements with equal hashes
+ * are identical up to hash collisions.
+ */
+class StatementHasher: public ASTWalker, public HasherBase
+{
+public:
+	/// @returns the hashes of the top-level statements of @a _block followed by a hash of its debug data.
+	static std::vector<uint64_t> run(Block const& _block);
+	/// @returns the hash of a single statement, as contained in the result of run().
+	static uint64_t hash(Statement const& _statement);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const& _break) override;
+	void operator()(Continue const& _continue) override;
+	void operator()(Leave const& _leaveStatement) override;
+	void operator()(Block const& _block) override;
+
+private:
+	void hashTypedNames(std::vector<TypedName> const& _names);
+	void hashDebugData(langutil::DebugData::ConstPtr const& _debugData) { hashPointer(_debugData.get()); }
+};
+
 }
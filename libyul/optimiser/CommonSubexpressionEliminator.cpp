@@ -24,6 +24,7 @@
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
@@ -37,11 +38,12 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	std::map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	processFunctionsConcurrently(_context, _ast, sideEffectsHash(functionSideEffects), [&](Block& _block) {
+		CommonSubexpressionEliminator cse{_context.dialect, functionSideEffects};
+		cse(_block);
+	});
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
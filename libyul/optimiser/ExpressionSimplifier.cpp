@@ -34,7 +34,9 @@ using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	processFunctionsConcurrently(_context, _ast, 0, [&](Block& _block) {
+		ExpressionSimplifier{_context.dialect}(_block);
+	});
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -44,12 +44,18 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	std::map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	// The expected number of executions is the same for all runs on the same AST.
+	uint64_t programInfoHash = 2 * sideEffectsHash(functionSideEffects) + (containsMSize ? 1 : 0);
+	processFunctionsConcurrently(_context, _ast, programInfoHash, [&](Block& _block) {
+		LoadResolver{
+			_context.dialect,
+			functionSideEffects,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		}(_block);
+	});
 }
 
 void LoadResolver::visit(Expression& _e)
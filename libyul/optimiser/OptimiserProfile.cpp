@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserProfile.h>
+
+#include <cstdint>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+int64_t toMicroseconds(std::chrono::steady_clock::duration _duration)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(_duration).count();
+}
+
+}
+
+void OptimiserProfile::record(StepRun _stepRun)
+{
+	std::lock_guard lock(m_mutex);
+	size_t thread = m_threadIndices.emplace(std::this_thread::get_id(), m_threadIndices.size()).first->second;
+	m_stepRuns.push_back({std::move(_stepRun), thread});
+}
+
+Json OptimiserProfile::toJson() const
+{
+	std::lock_guard lock(m_mutex);
+
+	Json steps = Json::array();
+	Json totals = Json::object();
+	Json traceEvents = Json::array();
+	for (auto const& [run, thread]: m_stepRuns)
+	{
+		int64_t const start = toMicroseconds(run.start - m_start);
+		int64_t const duration = toMicroseconds(run.duration);
+		int64_t const codeSizeDelta = static_cast<int64_t>(run.codeSizeAfter) - static_cast<int64_t>(run.codeSizeBefore);
+
+		Json step = Json::object();
+		step["object"] = run.object;
+		step["step"] = run.step;
+		step["round"] = run.round;
+		step["skipped"] = run.skipped;
+		step["start"] = start;
+		step["duration"] = duration;
+		step["codeSizeBefore"] = run.codeSizeBefore;
+		step["codeSizeAfter"] = run.codeSizeAfter;
+		if (run.allocations)
+			step["allocations"] = *run.allocations;
+		steps.emplace_back(std::move(step));
+
+		if (!totals.contains(run.step))
+		{
+			totals[run.step] = Json{{"runs", 0}, {"skipped", 0}, {"duration", 0}, {"codeSizeDelta", 0}};
+			if (run.allocations)
+				totals[run.step]["allocations"] = 0;
+		}
+		Json& total = totals[run.step];
+		if (run.skipped)
+		{
+			total["skipped"] = total["skipped"].get<size_t>() + 1;
+			continue;
+		}
+		total["runs"] = total["runs"].get<size_t>() + 1;
+		total["duration"] = total["duration"].get<int64_t>() + duration;
+		total["codeSizeDelta"] = total["codeSizeDelta"].get<int64_t>() + codeSizeDelta;
+		if (run.allocations && total.contains("allocations"))
+			total["allocations"] = total["allocations"].get<size_t>() + *run.allocations;
+
+		Json arguments = Json::object();
+		arguments["object"] = run.object;
+		arguments["round"] = run.round;
+		arguments["codeSizeBefore"] = run.codeSizeBefore;
+		arguments["codeSizeAfter"] = run.codeSizeAfter;
+		if (run.allocations)
+			arguments["allocations"] = *run.allocations;
+		traceEvents.emplace_back(Json{
+			{"name", run.step},
+			{"cat", "yul-optimizer"},
+			{"ph", "X"},
+			{"ts", start},
+			{"dur", duration},
+			{"pid", 0},
+			{"tid", thread},
+			{"args", std::move(arguments)}
+		});
+	}
+
+	Json profile = Json::object();
+	profile["steps"] = std::move(steps);
+	profile["totals"] = std::move(totals);
+	profile["traceEvents"] = std::move(traceEvents);
+	profile["displayTimeUnit"] = "ms";
+	return profile;
+}
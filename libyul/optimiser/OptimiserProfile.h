@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Record of the time spent in the optimiser steps and of their effect.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Record of the optimiser steps run on the objects of a Yul program: when and for how long
+ * each step ran, how it changed the size of the code and how many heap allocations it made.
+ *
+ * Steps can be recorded from multiple threads concurrently.
+ */
+class OptimiserProfile
+{
+public:
+	struct StepRun
+	{
+		/// Name of the Yul object the step was run on.
+		std::string object;
+		std::string step;
+		/// Round of the innermost bracketed part of the sequence the step was run in, starting at one.
+		/// Zero if the step is not part of a bracketed part.
+		size_t round = 0;
+		/// True if the step was not run because it could not have changed the code.
+		bool skipped = false;
+		std::chrono::steady_clock::time_point start;
+		std::chrono::steady_clock::duration duration{};
+		/// Size of the code before and after the step, as measured by CodeSize including functions.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+		/// Number of heap allocations made by the step. Not set if allocations are not counted.
+		std::optional<size_t> allocations;
+	};
+
+	OptimiserProfile(): m_start(std::chrono::steady_clock::now()) {}
+
+	/// Records a step run by the current thread.
+	void record(StepRun _stepRun);
+
+	/// @returns the profile as a JSON object with the list of all recorded steps ("steps"),
+	/// the totals per step ("totals") and the steps as Chrome trace events ("traceEvents"),
+	/// so that the object can be loaded as a trace by chrome://tracing or Perfetto.
+	/// Times are given in microseconds since the creation of the profile.
+	Json toJson() const;
+
+private:
+	struct RecordedStepRun
+	{
+		StepRun run;
+		/// Index of the recording thread in the order of the first recording of each thread.
+		size_t thread = 0;
+	};
+
+	std::chrono::steady_clock::time_point const m_start;
+	mutable std::mutex m_mutex;
+	std::vector<RecordedStepRun> m_stepRuns;
+	std::map<std::thread::id, size_t> m_threadIndices;
+};
+
+}
@@ -20,9 +20,12 @@
 
 #include <libyul/Exceptions.h>
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -32,6 +35,22 @@ struct Block;
 class YulString;
 class NameDispenser;
 
+/// Lets the OptimiserSuite skip the top-level statements of a grouped AST that a step which processes
+/// them independently of each other (see processFunctionsConcurrently) is known to leave unchanged.
+struct StatementChangeTracking
+{
+	/// Hashes of the top-level statements of the AST as computed by StatementHasher::run.
+	std::vector<uint64_t>& statementHashes;
+	/// Pairs of a statement hash and a hash of the information about the whole program used by the
+	/// step, for which the step is known to leave the statement unchanged.
+	std::set<std::pair<uint64_t, uint64_t>>& unchangedStatements;
+	/// Set by the step if it updated statementHashes for the statements it processed.
+	/// Otherwise the hashes of the whole AST have to be computed again.
+	bool hashesUpdated = false;
+	/// Number of statements skipped by the step.
+	size_t skippedStatements = 0;
+};
+
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
@@ -39,6 +58,10 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Maximum number of threads a step may use to process independent functions concurrently.
+	size_t jobs = 1;
+	/// Set by the OptimiserSuite while running a step, null otherwise.
+	StatementChangeTracking* changeTracking = nullptr;
 };
 
 
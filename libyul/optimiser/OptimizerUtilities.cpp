@@ -22,15 +22,23 @@
 #include <libyul/optimiser/OptimizerUtilities.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/FunctionGrouper.h>
 
+#include <libyul/ControlFlowSideEffects.h>
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
+#include <libyul/SideEffects.h>
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <algorithm>
+#include <exception>
+
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::util;
@@ -45,6 +53,14 @@ bool hasLeadingOrTrailingDot(std::string_view const _s)
 	return _s.front() == '.' || _s.back() == '.';
 }
 
+class ProgramInfoHasher: public HasherBase
+{
+public:
+	using HasherBase::hash8;
+	using HasherBase::hash64;
+	uint64_t hash() const { return m_hash; }
+};
+
 }
 
 void yul::removeEmptyBlocks(Block& _block)
@@ -75,6 +91,117 @@ langutil::EVMVersion const yul::evmVersionFromDialect(Dialect const& _dialect)
 	return langutil::EVMVersion();
 }
 
+void yul::processFunctionsConcurrently(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	uint64_t _programInfoHash,
+	std::function<void(Block&)> const& _processBlock
+)
+{
+	StatementChangeTracking* tracking = _context.changeTracking;
+	if (
+		(_context.jobs <= 1 && !tracking) ||
+		_ast.statements.size() <= 1 ||
+		!FunctionGrouper::alreadyGrouped(_ast)
+	)
+	{
+		_processBlock(_ast);
+		return;
+	}
+	if (tracking)
+		yulAssert(tracking->statementHashes.size() == _ast.statements.size() + 1);
+
+	std::vector<size_t> toProcess;
+	for (size_t index = 0; index < _ast.statements.size(); ++index)
+		if (tracking && tracking->unchangedStatements.count({tracking->statementHashes[index], _programInfoHash}))
+			++tracking->skippedStatements;
+		else
+			toProcess.emplace_back(index);
+
+	// Use more parts than threads, because the sizes of the functions vary a lot.
+	size_t const partCount = std::min(toProcess.size(), 8 * std::max<size_t>(_context.jobs, 1));
+	auto partBegin = [&](size_t _part) { return _part * toProcess.size() / partCount; };
+	std::vector<Block> parts(partCount);
+	for (size_t part = 0; part < partCount; ++part)
+	{
+		parts[part].debugData = _ast.debugData;
+		for (size_t i = partBegin(part); i < partBegin(part + 1); ++i)
+			parts[part].statements.emplace_back(std::move(_ast.statements[toProcess[i]]));
+	}
+
+	std::vector<std::vector<uint64_t>> newHashes(partCount);
+	std::exception_ptr exception;
+	try
+	{
+		util::parallelFor(partCount, _context.jobs, [&](size_t _part) {
+			_processBlock(parts[_part]);
+			if (tracking)
+				for (Statement const& statement: parts[_part].statements)
+					newHashes[_part].emplace_back(StatementHasher::hash(statement));
+		});
+	}
+	catch (...)
+	{
+		exception = std::current_exception();
+	}
+
+	for (size_t part = 0; part < partCount; ++part)
+	{
+		yulAssert(parts[part].statements.size() == partBegin(part + 1) - partBegin(part));
+		for (size_t i = partBegin(part); i < partBegin(part + 1); ++i)
+			_ast.statements[toProcess[i]] = std::move(parts[part].statements[i - partBegin(part)]);
+	}
+	if (exception)
+		std::rethrow_exception(exception);
+
+	if (tracking)
+	{
+		for (size_t part = 0; part < partCount; ++part)
+			for (size_t i = partBegin(part); i < partBegin(part + 1); ++i)
+			{
+				uint64_t& statementHash = tracking->statementHashes[toProcess[i]];
+				uint64_t newHash = newHashes[part][i - partBegin(part)];
+				if (newHash == statementHash)
+					tracking->unchangedStatements.emplace(statementHash, _programInfoHash);
+				else
+					statementHash = newHash;
+			}
+		tracking->hashesUpdated = true;
+	}
+}
+
+uint64_t yul::sideEffectsHash(std::map<YulString, SideEffects> const& _sideEffects)
+{
+	ProgramInfoHasher hasher;
+	for (auto const& [name, sideEffects]: _sideEffects)
+	{
+		hasher.hash64(name.hash());
+		hasher.hash8(sideEffects.movable);
+		hasher.hash8(sideEffects.movableApartFromEffects);
+		hasher.hash8(sideEffects.canBeRemoved);
+		hasher.hash8(sideEffects.canBeRemovedIfNoMSize);
+		hasher.hash8(sideEffects.cannotLoop);
+		hasher.hash8(static_cast<uint8_t>(sideEffects.otherState));
+		hasher.hash8(static_cast<uint8_t>(sideEffects.storage));
+		hasher.hash8(static_cast<uint8_t>(sideEffects.memory));
+		hasher.hash8(static_cast<uint8_t>(sideEffects.transientStorage));
+	}
+	return hasher.hash();
+}
+
+uint64_t yul::sideEffectsHash(std::map<YulString, ControlFlowSideEffects> const& _sideEffects)
+{
+	ProgramInfoHasher hasher;
+	for (auto const& [name, sideEffects]: _sideEffects)
+	{
+		hasher.hash64(name.hash());
+		hasher.hash8(sideEffects.canTerminate);
+		hasher.hash8(sideEffects.canRevert);
+		hasher.hash8(sideEffects.canContinue);
+	}
+	return hasher.hash();
+}
+
 void StatementRemover::operator()(Block& _block)
 {
 	util::iterateReplacing(
@@ -26,8 +26,12 @@
 #include <libyul/Dialect.h>
 #include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <optional>
 
 namespace solidity::evmasm
@@ -38,6 +42,9 @@ enum class Instruction: uint8_t;
 namespace solidity::yul
 {
 
+struct SideEffects;
+struct ControlFlowSideEffects;
+
 /// Removes statements that are just empty blocks (non-recursive).
 /// If this is run on the outermost block, the FunctionGrouper should be run afterwards to keep
 /// the canonical form.
@@ -54,6 +61,25 @@ std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, Yul
 /// It returns the default EVM version if dialect is not an EVMDialect.
 langutil::EVMVersion const evmVersionFromDialect(Dialect const& _dialect);
 
+/// Calls @a _processBlock on the outermost block @a _ast or, if it is grouped (see FunctionGrouper),
+/// on blocks that together contain its top-level statements, using up to `_context.jobs` threads.
+/// The statements are moved back into @a _ast afterwards.
+/// This can be used for steps that process each function independently of the others and only
+/// need information about the whole program that is computed before. @a _programInfoHash has to
+/// be a hash of that information: If the OptimiserSuite tracks changes, statements that the step
+/// already left unchanged together with the same information are skipped.
+void processFunctionsConcurrently(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	uint64_t _programInfoHash,
+	std::function<void(Block&)> const& _processBlock
+);
+
+/// @returns a hash of the side effects of functions, to be used as part of the program
+/// information hash passed to processFunctionsConcurrently.
+uint64_t sideEffectsHash(std::map<YulString, SideEffects> const& _sideEffects);
+uint64_t sideEffectsHash(std::map<YulString, ControlFlowSideEffects> const& _sideEffects);
+
 class StatementRemover: public ASTModifier
 {
 public:
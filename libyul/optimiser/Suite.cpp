@@ -24,6 +24,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
@@ -62,6 +63,7 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -71,6 +73,7 @@
 
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libsolutil/AllocationCounter.h>
 #include <libsolutil/CommonData.h>
 
 #include <libyul/CompilabilityChecker.h>
@@ -80,11 +83,11 @@
 #include <range/v3/algorithm/count.hpp>
 #include <range/v3/algorithm/none_of.hpp>
 
+#include <chrono>
 #include <limits>
 #include <tuple>
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
 #include <fmt/format.h>
 #endif
 
@@ -141,7 +144,9 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulString> const& _externallyUsedIdentifiers
+	std::set<YulString> const& _externallyUsedIdentifiers,
+	size_t _jobs,
+	OptimiserProfile* _profile
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -161,15 +166,17 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment, _jobs};
 
 	OptimiserSuite suite(context, Debug::None);
+	suite.m_profile = _profile;
+	suite.m_objectName = _object.name.str();
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
 	suite.runSequence("hgfo", ast);
 
-	NameSimplifier::run(suite.m_context, ast);
+	suite.runStep("NameSimplifier", ast, [&]() { NameSimplifier::run(suite.m_context, ast); });
 	// Now the user-supplied part
 	suite.runSequence(_optimisationSequence, ast);
 
@@ -180,12 +187,14 @@ void OptimiserSuite::run(
 	// We ignore the return value because we will get a much better error
 	// message once we perform code generation.
 	if (!usesOptimizedCodeGenerator)
-		StackCompressor::run(
-			_dialect,
-			_object,
-			_optimizeStackAllocation,
-			stackCompressorMaxIterations
-		);
+		suite.runStep("StackCompressor", ast, [&]() {
+			StackCompressor::run(
+				_dialect,
+				_object,
+				_optimizeStackAllocation,
+				stackCompressorMaxIterations
+			);
+		});
 
 	// Run the user-supplied clean up sequence
 	suite.runSequence(_optimisationCleanupSequence, ast);
@@ -197,25 +206,27 @@ void OptimiserSuite::run(
 	if (evmDialect)
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*evmDialect, *_meter}(ast);
+		suite.runStep("ConstantOptimiser", ast, [&]() { ConstantOptimiser{*evmDialect, *_meter}(ast); });
 		if (usesOptimizedCodeGenerator)
 		{
-			StackCompressor::run(
-				_dialect,
-				_object,
-				_optimizeStackAllocation,
-				stackCompressorMaxIterations
-			);
+			suite.runStep("StackCompressor", ast, [&]() {
+				StackCompressor::run(
+					_dialect,
+					_object,
+					_optimizeStackAllocation,
+					stackCompressorMaxIterations
+				);
+			});
 			if (evmDialect->providesObjectAccess())
-				StackLimitEvader::run(suite.m_context, _object);
+				suite.runStep("StackLimitEvader", ast, [&]() { StackLimitEvader::run(suite.m_context, _object); });
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
-			StackLimitEvader::run(suite.m_context, _object);
+			suite.runStep("StackLimitEvader", ast, [&]() { StackLimitEvader::run(suite.m_context, _object); });
 	}
 
 	dispenser.reset(ast);
-	NameSimplifier::run(suite.m_context, ast);
-	VarNameCleaner::run(suite.m_context, ast);
+	suite.runStep("NameSimplifier", ast, [&]() { NameSimplifier::run(suite.m_context, ast); });
+	suite.runStep("VarNameCleaner", ast, [&]() { VarNameCleaner::run(suite.m_context, ast); });
 
 #ifdef PROFILE_OPTIMIZER_STEPS
 	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
@@ -245,42 +256,41 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	// Initialized in the declaration, which is guaranteed to happen only once, even with multiple threads.
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -392,7 +402,7 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 		ranges::none_of(_sequence, [](auto _step) { return _step != ':' && _step != ' ' && _step != '\n'; });
 }
 
-void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
+bool OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
 
@@ -465,17 +475,28 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 	// NOTE: If _repeatUntilStable is false, the value will not be used so do not calculate it.
 	size_t codeSize = (_repeatUntilStable ? CodeSize::codeSizeIncludingFunctions(_ast) : 0);
 
+	size_t const outerRound = m_round;
+	bool changed = false;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		if (_repeatUntilStable)
+			m_round = round + 1;
+		bool changedInRound = false;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
-				runSequence(subsequence, _ast, true);
-			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+			{
+				if (runSequence(subsequence, _ast, true))
+					changedInRound = true;
+			}
+			else if (runSequence(abbreviationsToSteps(subsequence), _ast))
+				changedInRound = true;
 		}
+		changed = changed || changedInRound;
 
-		if (!_repeatUntilStable)
+		// A round that did not change the AST has reached the fixed point, so there is
+		// no need to compute the code size to find out.
+		if (!_repeatUntilStable || !changedInRound)
 			break;
 
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
@@ -483,25 +504,62 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 			break;
 		codeSize = newSize;
 	}
+	m_round = outerRound;
+	return changed;
 }
 
-void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+bool OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
 {
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+
+	// Hashed per top-level statement, i.e. per function once the AST is grouped, so that
+	// a change is detected without keeping a copy of the AST around. Steps that process
+	// functions independently update the hashes of the functions they process and skip the
+	// functions they are known not to change. After other steps, the whole AST is hashed again.
+	// The AST might have been modified outside of the suite since the last call.
+	std::vector<uint64_t> statementHashes = StatementHasher::run(_ast);
+	bool changed = false;
 	for (std::string const& step: _steps)
 	{
+		// The steps are deterministic, so a step that did not change the AST
+		// will not change it when run on the same AST again.
+		if (auto fixedPoint = m_fixedPoints.find(step); fixedPoint != m_fixedPoints.end() && fixedPoint->second == statementHashes)
+		{
+			if (m_debug == Debug::PrintStep)
+				std::cout << "Skipping " << step << " (no changes since its last run)" << std::endl;
+			recordSkippedStep(step, _ast);
+			continue;
+		}
+
 		if (m_debug == Debug::PrintStep)
 			std::cout << "Running " << step << std::endl;
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point startTime = steady_clock::now();
 #endif
-		allSteps().at(step)->run(m_context, _ast);
+		std::vector<uint64_t> newStatementHashes = statementHashes;
+		StatementChangeTracking tracking{newStatementHashes, m_unchangedStatements[step]};
+		m_context.changeTracking = &tracking;
+		ScopeGuard resetChangeTracking([&]() { m_context.changeTracking = nullptr; });
+		runStep(step, _ast, [&]() { allSteps().at(step)->run(m_context, _ast); });
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point endTime = steady_clock::now();
 		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
 #endif
+		if (m_debug == Debug::PrintStep && tracking.skippedStatements > 0)
+			std::cout << "Skipped " << tracking.skippedStatements << " unchanged top-level statements" << std::endl;
+
+		if (!tracking.hashesUpdated)
+			newStatementHashes = StatementHasher::run(_ast);
+		if (newStatementHashes == statementHashes)
+			m_fixedPoints[step] = statementHashes;
+		else
+		{
+			statementHashes = std::move(newStatementHashes);
+			changed = true;
+		}
+
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -515,4 +573,45 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 			}
 		}
 	}
+	return changed;
+}
+
+void OptimiserSuite::runStep(std::string const& _stepName, Block const& _ast, std::function<void()> const& _step)
+{
+	if (!m_profile)
+	{
+		_step();
+		return;
+	}
+
+	OptimiserProfile::StepRun stepRun;
+	stepRun.object = m_objectName;
+	stepRun.step = _stepName;
+	stepRun.round = m_round;
+	stepRun.codeSizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+	// Only the allocations of this thread are counted, not the ones of the threads
+	// used to process functions concurrently.
+	size_t const allocationsBefore = util::AllocationCounter::allocations();
+	stepRun.start = std::chrono::steady_clock::now();
+	_step();
+	stepRun.duration = std::chrono::steady_clock::now() - stepRun.start;
+	if (util::AllocationCounter::enabled())
+		stepRun.allocations = util::AllocationCounter::allocations() - allocationsBefore;
+	stepRun.codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+	m_profile->record(std::move(stepRun));
+}
+
+void OptimiserSuite::recordSkippedStep(std::string const& _stepName, Block const& _ast)
+{
+	if (!m_profile)
+		return;
+
+	OptimiserProfile::StepRun stepRun;
+	stepRun.object = m_objectName;
+	stepRun.step = _stepName;
+	stepRun.round = m_round;
+	stepRun.skipped = true;
+	stepRun.start = std::chrono::steady_clock::now();
+	stepRun.codeSizeBefore = stepRun.codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+	m_profile->record(std::move(stepRun));
 }
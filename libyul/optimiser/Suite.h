@@ -27,6 +27,7 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -39,6 +40,7 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimiserProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -62,6 +64,8 @@ public:
 	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// Steps that process functions independently use up to @a _jobs threads.
+	/// If @a _profile is given, all steps run on the object are recorded in it.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +74,9 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _jobs = 1,
+		OptimiserProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -81,16 +87,37 @@ public:
 	static bool isEmptyOptimizerSequence(std::string const& _sequence);
 
 
-	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
-	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
+	/// Runs the given steps, skipping those that are known not to change the AST in its current state.
+	/// @returns true if any of the steps changed the AST.
+	bool runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs the given sequence. Bracketed parts are repeated until a round does not change the AST
+	/// or the code size, but at most MaxRounds times.
+	/// @returns true if any of the steps changed the AST.
+	bool runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Runs @a _step, which modifies @a _ast, and records it in the profile (if any) as @a _stepName.
+	void runStep(std::string const& _stepName, Block const& _ast, std::function<void()> const& _step);
+	/// Records in the profile (if any) that the step @a _stepName was skipped.
+	void recordSkippedStep(std::string const& _stepName, Block const& _ast);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	/// For each step, the hashes of the top-level statements of the AST the step was last run on
+	/// without changing it. Running the step on an AST with the same hashes can be skipped.
+	std::map<std::string, std::vector<uint64_t>> m_fixedPoints;
+	/// For each step that processes functions independently, the statements it is known to
+	/// leave unchanged (see StatementChangeTracking).
+	std::map<std::string, std::set<std::pair<uint64_t, uint64_t>>> m_unchangedStatements;
+	OptimiserProfile* m_profile = nullptr;
+	/// Name of the object being optimized, for the profile.
+	std::string m_objectName;
+	/// Current round of the innermost bracketed part of the sequence, zero outside of brackets.
+	size_t m_round = 0;
 #ifdef PROFILE_OPTIMIZER_STEPS
 	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
 #endif
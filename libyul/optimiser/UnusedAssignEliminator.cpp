@@ -39,17 +39,18 @@ using namespace solidity::yul;
 
 void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedAssignEliminator uae{
-		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	};
-	uae(_ast);
-
-	uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
-
-	std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
-	StatementRemover remover{toRemove};
-	remover(_ast);
+	std::map<YulString, ControlFlowSideEffects> controlFlowSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	processFunctionsConcurrently(_context, _ast, sideEffectsHash(controlFlowSideEffects), [&](Block& _block) {
+		UnusedAssignEliminator uae{_context.dialect, controlFlowSideEffects};
+		uae(_block);
+
+		uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
+
+		std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
+		StatementRemover remover{toRemove};
+		remover(_block);
+	});
 }
 
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
@@ -32,6 +32,8 @@
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -333,6 +335,32 @@ void CommandLineInterface::handleIROptimizedAst(std::string const& _contractName
 	}
 }
 
+void CommandLineInterface::handleOptimizerProfile(std::string const& _contractName)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	// There is no profile if the IR of the contract was not optimized.
+	if (!m_options.compiler.outputs.optimizerProfile || m_compiler->optimizerProfile(_contractName).is_null())
+		return;
+
+	if (!m_options.output.dir.empty())
+		createFile(
+			m_compiler->filesystemFriendlyName(_contractName) + "_optimizer_profile.json",
+			util::jsonPrint(
+				m_compiler->optimizerProfile(_contractName),
+				m_options.formatting.json
+			)
+		);
+	else
+	{
+		sout() << "Optimizer profile:" << std::endl;
+		sout() << util::jsonPrint(
+			m_compiler->optimizerProfile(_contractName),
+			m_options.formatting.json
+		) << std::endl;
+	}
+}
+
 void CommandLineInterface::handleBytecode(std::string const& _contract)
 {
 	solAssert(
@@ -748,8 +776,13 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		compiler.setCompilationCache(openCompilationCache());
+		compiler.setSMTQueryCache(openSMTQueryCache());
+		std::optional<std::string> fatalError = compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
+		if (fatalError)
+			solThrow(CommandLineExecutionError, "Error after the standard JSON output had been printed: " + *fatalError);
 		break;
 	}
 	case InputMode::LanguageServer:
@@ -816,6 +849,56 @@ void CommandLineInterface::assembleFromEVMAssemblyJSON()
 	m_assemblyStack = m_evmAssemblyStack.get();
 }
 
+std::shared_ptr<CompilationCache> CommandLineInterface::openCompilationCache() const
+{
+	if (!m_options.output.compilationCacheDirectory)
+		return nullptr;
+
+	try
+	{
+		return std::make_shared<CompilationCache>(
+			*m_options.output.compilationCacheDirectory,
+			m_options.output.compilationCacheMaxEntries
+		);
+	}
+	catch (boost::filesystem::filesystem_error const& _error)
+	{
+		solThrow(CommandLineExecutionError, "Could not open the compilation cache: "s + _error.what());
+	}
+}
+
+std::shared_ptr<SMTQueryCache> CommandLineInterface::openSMTQueryCache() const
+{
+	if (!m_options.modelChecker.cacheDirectory)
+		return nullptr;
+
+	try
+	{
+		return std::make_shared<SMTQueryCache>(
+			*m_options.modelChecker.cacheDirectory,
+			m_options.modelChecker.cacheMaxEntries
+		);
+	}
+	catch (boost::filesystem::filesystem_error const& _error)
+	{
+		solThrow(CommandLineExecutionError, "Could not open the model checker cache: "s + _error.what());
+	}
+}
+
+void CommandLineInterface::printCompilationCacheStatistics(std::shared_ptr<CompilationCache> const& _cache)
+{
+	if (!_cache)
+		return;
+
+	CompilationCache::Statistics const& statistics = _cache->statistics();
+	serr() <<
+		"Compilation cache: " <<
+		statistics.hits << " hits, " <<
+		statistics.misses << " misses, " <<
+		statistics.evictions << " evictions." <<
+		std::endl;
+}
+
 void CommandLineInterface::compile()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -835,9 +918,14 @@ void CommandLineInterface::compile()
 		m_compiler->setMetadataHash(m_options.metadata.hash);
 		if (m_options.modelChecker.initialize)
 			m_compiler->setModelCheckerSettings(m_options.modelChecker.settings);
+		std::shared_ptr<SMTQueryCache> smtQueryCache = openSMTQueryCache();
+		m_compiler->setSMTQueryCache(smtQueryCache);
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setJobs(m_options.output.jobs);
+		std::shared_ptr<CompilationCache> compilationCache = openCompilationCache();
+		m_compiler->setCompilationCache(compilationCache);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -850,6 +938,27 @@ void CommandLineInterface::compile()
 			m_options.compiler.outputs.irAstJson ||
 			m_options.compiler.outputs.irOptimizedAstJson
 		);
+		m_compiler->enableOptimizerProfiling(m_options.compiler.outputs.optimizerProfile);
+		std::set<CompilerStack::Artifact> requestedArtifacts;
+		CombinedJsonRequests const* combinedJsonRequests =
+			m_options.compiler.combinedJsonRequests ? &*m_options.compiler.combinedJsonRequests : nullptr;
+		if (m_options.compiler.outputs.asm_)
+			requestedArtifacts.insert(CompilerStack::Artifact::Assembly);
+		if (m_options.compiler.outputs.asmJson || (combinedJsonRequests && combinedJsonRequests->asm_))
+			requestedArtifacts.insert(CompilerStack::Artifact::AssemblyJSON);
+		if (m_options.compiler.estimateGas)
+			requestedArtifacts.insert(CompilerStack::Artifact::GasEstimates);
+		if (combinedJsonRequests && (combinedJsonRequests->generatedSources || combinedJsonRequests->generatedSourcesRuntime))
+			requestedArtifacts.insert(CompilerStack::Artifact::GeneratedSources);
+		if (combinedJsonRequests && (combinedJsonRequests->srcMap || combinedJsonRequests->srcMapRuntime))
+			requestedArtifacts.insert(CompilerStack::Artifact::SourceMappings);
+		if (m_options.compiler.outputs.irOptimized)
+			requestedArtifacts.insert(CompilerStack::Artifact::IROptimized);
+		if (m_options.compiler.outputs.irAstJson)
+			requestedArtifacts.insert(CompilerStack::Artifact::IRAst);
+		if (m_options.compiler.outputs.irOptimizedAstJson)
+			requestedArtifacts.insert(CompilerStack::Artifact::IROptimizedAst);
+		m_compiler->setRequestedArtifacts(std::move(requestedArtifacts));
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
 			m_options.compiler.outputs.asm_ ||
@@ -903,6 +1012,19 @@ void CommandLineInterface::compile()
 			formatter.printErrorInformation(*error);
 		}
 
+		printCompilationCacheStatistics(compilationCache);
+
+		if (smtQueryCache)
+		{
+			CompilationCache::Statistics const& statistics = smtQueryCache->statistics();
+			serr() <<
+				"Model checker cache: " <<
+				statistics.hits << " hits, " <<
+				statistics.misses << " misses, " <<
+				statistics.evictions << " evictions." <<
+				std::endl;
+		}
+
 		if (!successful)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -1303,6 +1425,7 @@ void CommandLineInterface::outputCompilationResults()
 			handleIRAst(contract);
 			handleIROptimized(contract);
 			handleIROptimizedAst(contract);
+			handleOptimizerProfile(contract);
 			handleSignatureHashes(contract);
 			handleMetadata(contract);
 			handleABI(contract);
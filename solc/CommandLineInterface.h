@@ -86,6 +86,12 @@ private:
 	void printVersion();
 	void printLicense();
 	void compile();
+	/// @returns the cache requested with --compilation-cache or nullptr if none was requested.
+	std::shared_ptr<CompilationCache> openCompilationCache() const;
+	/// Prints the statistics of @a _cache, if any, to stderr.
+	void printCompilationCacheStatistics(std::shared_ptr<CompilationCache> const& _cache);
+	/// @returns the cache requested with --model-checker-cache or nullptr if none was requested.
+	std::shared_ptr<SMTQueryCache> openSMTQueryCache() const;
 	void assembleFromEVMAssemblyJSON();
 	void serveLSP();
 	void link();
@@ -108,6 +114,7 @@ private:
 	void handleIRAst(std::string const& _contract);
 	void handleIROptimized(std::string const& _contract);
 	void handleIROptimizedAst(std::string const& _contract);
+	void handleOptimizerProfile(std::string const& _contract);
 	void handleBytecode(std::string const& _contract);
 	void handleSignatureHashes(std::string const& _contract);
 	void handleMetadata(std::string const& _contract);
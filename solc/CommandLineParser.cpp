@@ -54,6 +54,9 @@ static std::string const g_strGas = "gas";
 static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
+static std::string const g_strJobs = "jobs";
+static std::string const g_strCompilationCache = "compilation-cache";
+static std::string const g_strCompilationCacheMaxEntries = "compilation-cache-max-entries";
 static std::string const g_strInputFile = "input-file";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
@@ -67,11 +70,15 @@ static std::string const g_strMachine = "machine";
 static std::string const g_strNoCBORMetadata = "no-cbor-metadata";
 static std::string const g_strMetadataHash = "metadata-hash";
 static std::string const g_strMetadataLiteral = "metadata-literal";
+static std::string const g_strModelCheckerCache = "model-checker-cache";
+static std::string const g_strModelCheckerCacheMaxEntries = "model-checker-cache-max-entries";
 static std::string const g_strModelCheckerContracts = "model-checker-contracts";
+static std::string const g_strModelCheckerDetectSolverConflicts = "model-checker-detect-solver-conflicts";
 static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
+static std::string const g_strModelCheckerJobs = "model-checker-jobs";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
@@ -235,6 +242,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.jobs == _other.output.jobs &&
+		output.compilationCacheDirectory == _other.output.compilationCacheDirectory &&
+		output.compilationCacheMaxEntries == _other.output.compilationCacheMaxEntries &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -257,7 +267,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		modelChecker.cacheDirectory == _other.modelChecker.cacheDirectory &&
+		modelChecker.cacheMaxEntries == _other.modelChecker.cacheMaxEntries;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -627,6 +639,28 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads for compilation. Currently only the parsing of source units, "
+			"the optimization and assembly of the IR of independent contracts, some optimizer steps "
+			"on independent functions and the optimization of independent sub-assemblies are "
+			"performed concurrently. "
+			"Does not affect the output."
+		)
+		(
+			g_strCompilationCache.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Store the compiled contracts in the given directory and reuse them in later compilations "
+			"with unchanged sources and settings instead of compiling them again. Does not affect the output."
+		)
+		(
+			g_strCompilationCacheMaxEntries.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			("Keep at most n contracts in the directory given with --" + g_strCompilationCache + ", "
+			"evicting the least recently used ones. Other files in the directory are never removed. "
+			"Unlimited by default.").c_str()
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -760,6 +794,12 @@ General Information)").c_str(),
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecDev).c_str(), "Natspec developer documentation of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::metadata).c_str(), "Combined Metadata JSON whose IPFS hash is stored on-chain.")
 		(CompilerOutputs::componentName(&CompilerOutputs::storageLayout).c_str(), "Slots, offsets and types of the contract's state variables.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::optimizerProfile).c_str(),
+			"Time, code size change and heap allocations of each Yul optimizer step run on the IR of the contracts, "
+			"in a JSON format that can also be loaded as a trace by chrome://tracing or Perfetto. "
+			"Only available for contracts whose IR is optimized for other outputs or with --via-ir."
+		)
 	;
 	desc.add(outputComponents);
 
@@ -829,6 +869,19 @@ General Information)").c_str(),
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Look up the results of solver queries in the given directory before invoking a solver"
+			" and add new results to it. Can be shared between compiler runs. Does not affect the output."
+		)
+		(
+			g_strModelCheckerCacheMaxEntries.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			("Keep at most n query results in the directory given with --" + g_strModelCheckerCache + ", "
+			"evicting the least recently used ones. Other files in the directory are never removed. "
+			"Unlimited by default.").c_str()
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<std::string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -836,6 +889,11 @@ General Information)").c_str(),
 			"Multiple pairs <source>:<contract> can be selected at the same time, separated by a comma "
 			"and no spaces."
 		)
+		(
+			g_strModelCheckerDetectSolverConflicts.c_str(),
+			"Query the enabled SMT solvers one after another and report when they disagree"
+			" instead of querying them concurrently, which does not detect conflicting answers."
+		)
 		(
 			g_strModelCheckerDivModNoSlacks.c_str(),
 			"Encode division and modulo operations with their precise operators"
@@ -859,6 +917,12 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to check the verification targets of the BMC engine."
+			" Does not affect the output. Default is 1."
+		)
 		(
 			g_strModelCheckerPrintQuery.c_str(),
 			"Print the queries created by the SMTChecker in the SMTLIB2 format."
@@ -992,13 +1056,20 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCompilationCache, {InputMode::Compiler, InputMode::StandardJson}},
+		{g_strCompilationCacheMaxEntries, {InputMode::Compiler, InputMode::StandardJson}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCache, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
+		{g_strModelCheckerCacheMaxEntries, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerDetectSolverConflicts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerPrintQuery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1184,6 +1255,38 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
+	if (m_args.count(g_strCompilationCache))
+	{
+		m_options.output.compilationCacheDirectory = m_args[g_strCompilationCache].as<std::string>();
+		if (m_options.output.compilationCacheDirectory->empty())
+			solThrow(CommandLineValidationError, "--" + g_strCompilationCache + " requires a non-empty path.");
+	}
+	if (m_args.count(g_strCompilationCacheMaxEntries))
+	{
+		if (!m_options.output.compilationCacheDirectory)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strCompilationCacheMaxEntries + " can only be used together with --" + g_strCompilationCache + "."
+			);
+		m_options.output.compilationCacheMaxEntries = m_args[g_strCompilationCacheMaxEntries].as<unsigned>();
+	}
+
+	if (m_args.count(g_strModelCheckerCache))
+	{
+		m_options.modelChecker.cacheDirectory = m_args[g_strModelCheckerCache].as<std::string>();
+		if (m_options.modelChecker.cacheDirectory->empty())
+			solThrow(CommandLineValidationError, "--" + g_strModelCheckerCache + " requires a non-empty path.");
+	}
+	if (m_args.count(g_strModelCheckerCacheMaxEntries))
+	{
+		if (!m_options.modelChecker.cacheDirectory)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strModelCheckerCacheMaxEntries + " can only be used together with --" + g_strModelCheckerCache + "."
+			);
+		m_options.modelChecker.cacheMaxEntries = m_args[g_strModelCheckerCacheMaxEntries].as<unsigned>();
+	}
+
 	if (m_options.input.mode == InputMode::StandardJson)
 		return;
 
@@ -1345,6 +1448,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.contracts = std::move(*contracts);
 	}
 
+	if (m_args.count(g_strModelCheckerDetectSolverConflicts))
+		m_options.modelChecker.settings.detectSolverConflicts = true;
+
 	if (m_args.count(g_strModelCheckerDivModNoSlacks))
 		m_options.modelChecker.settings.divModNoSlacks = true;
 
@@ -1375,6 +1481,13 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerJobs))
+	{
+		m_options.modelChecker.settings.jobs = m_args[g_strModelCheckerJobs].as<unsigned>();
+		if (m_options.modelChecker.settings.jobs == 0)
+			solThrow(CommandLineValidationError, "--" + g_strModelCheckerJobs + " must be at least 1.");
+	}
+
 	if (m_args.count(g_strModelCheckerShowProvedSafe))
 		m_options.modelChecker.settings.showProvedSafe = true;
 
@@ -1422,10 +1535,12 @@ void CommandLineParser::processArgs()
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
 		m_args.count(g_strModelCheckerContracts) ||
+		m_args.count(g_strModelCheckerDetectSolverConflicts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerJobs) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
@@ -1434,6 +1549,10 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
+	if (m_options.output.jobs == 0)
+		solThrow(CommandLineValidationError, "--" + g_strJobs + " must be at least 1.");
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
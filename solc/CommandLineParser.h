@@ -86,6 +86,7 @@ struct CompilerOutputs
 			{"devdoc", &CompilerOutputs::natspecDev},
 			{"metadata", &CompilerOutputs::metadata},
 			{"storage-layout", &CompilerOutputs::storageLayout},
+			{"optimizer-profile", &CompilerOutputs::optimizerProfile},
 		};
 		return components;
 	}
@@ -106,6 +107,7 @@ struct CompilerOutputs
 	bool natspecDev = false;
 	bool metadata = false;
 	bool storageLayout = false;
+	bool optimizerProfile = false;
 };
 
 struct CombinedJsonRequests
@@ -184,6 +186,9 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		unsigned jobs = 1;
+		std::optional<boost::filesystem::path> compilationCacheDirectory;
+		unsigned compilationCacheMaxEntries = 0;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -234,6 +239,8 @@ struct CommandLineOptions
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		std::optional<boost::filesystem::path> cacheDirectory;
+		unsigned cacheMaxEntries = 0;
 	} modelChecker;
 };
 
@@ -25,15 +25,53 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/AllocationCounter.h>
+
 #include <boost/exception/all.hpp>
 
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 using namespace solidity;
 
+#ifdef COUNT_ALLOCATIONS
+// Count the heap allocations so that they can be reported by ``--optimizer-profile``.
+// All other forms of ``new`` and ``delete`` are implemented in terms of these
+// by the standard library, except for the ones with an alignment argument.
+void* operator new(std::size_t _size)
+{
+	util::AllocationCounter::count();
+	if (_size == 0)
+		_size = 1;
+	while (true)
+	{
+		if (void* memory = std::malloc(_size))
+			return memory;
+		// Like the default implementation, give the new handler a chance to free memory.
+		std::new_handler handler = std::get_new_handler();
+		if (!handler)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void operator delete(void* _memory) noexcept
+{
+	std::free(_memory);
+}
+
+void operator delete(void* _memory, std::size_t) noexcept
+{
+	std::free(_memory);
+}
+#endif
 
 int main(int argc, char** argv)
 {
+#ifdef COUNT_ALLOCATIONS
+	util::AllocationCounter::enable();
+#endif
 	try
 	{
 		solidity::frontend::CommandLineInterface cli(std::cin, std::cout, std::cerr);
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+# Checks that the model checker reports the same results regardless of how many
+# solver queries it runs concurrently. No timeout is given, so the solvers run with
+# their deterministic resource limit.
+
+function model_checker_output
+{
+    local solidity_file="$1"
+    local jobs="$2"
+
+    # Some of the test files are expected to fail compilation. We only care about
+    # the output being the same, so the exit code is part of the compared value.
+    local exit_code=0
+    "$SOLC" "$solidity_file" \
+        --model-checker-engine all \
+        --model-checker-targets all \
+        --model-checker-jobs "$jobs" \
+        2>&1 || exit_code=$?
+    echo "exit code: ${exit_code}"
+}
+
+SOLTMPDIR=$(mktemp -d -t "cmdline-test-model-checker-jobs-equivalence-XXXXXX")
+pushd "$SOLTMPDIR" > /dev/null
+
+test_directories=(
+    "${REPO_ROOT}/test/libsolidity/smtCheckerTests/loops"
+    "${REPO_ROOT}/test/libsolidity/smtCheckerTests/operators"
+    "${REPO_ROOT}/test/libsolidity/smtCheckerTests/functions"
+)
+
+for solidity_file in $(find "${test_directories[@]}" -name "*.sol" | sort); do
+    # Multi-source tests and imports need the isoltest source splitting.
+    grep -qE '^(==== Source|import )' "$solidity_file" && continue
+
+    # The test file path is part of the output, so compile a local copy.
+    cp "$solidity_file" input.sol
+
+    output_sequential=$(model_checker_output input.sol 1)
+    output_concurrent=$(model_checker_output input.sol 4)
+
+    diff_values "$output_sequential" "$output_concurrent" ||
+        fail "Output of --model-checker-jobs 1 and 4 differs for ${solidity_file}."
+done
+
+popd > /dev/null
+rm -r "$SOLTMPDIR"
@@ -420,6 +420,96 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(minimal_tag_pushes)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto createAssembly = [&]() {
+		Assembly assembly{evmVersion, false, {}};
+		AssemblyItem early = assembly.newTag();
+		AssemblyItem late = assembly.newTag();
+		assembly.append(early);
+		assembly.append(early.pushTag());
+		assembly.append(Instruction::JUMP);
+		assembly.append(late.pushTag());
+		for (size_t i = 0; i < 300; ++i)
+			assembly.append(Instruction::CALLVALUE);
+		assembly.append(late);
+		return assembly;
+	};
+	std::string padding;
+	for (size_t i = 0; i < 300; ++i)
+		padding += "34";
+
+	Assembly::OptimiserSettings settings;
+	settings.evmVersion = evmVersion;
+	Assembly uniform = createAssembly();
+	uniform.optimise(settings);
+	// All tags are pushed with two bytes because the code is longer than 256 bytes.
+	BOOST_CHECK_EQUAL(uniform.assemble().toHex(), "5b" "610000" "56" "610134" + padding + "5b");
+
+	settings.minimalTagPushes = true;
+	Assembly minimal = createAssembly();
+	minimal.optimise(settings);
+	// The first tag fits into one byte, which moves the second one.
+	BOOST_CHECK_EQUAL(minimal.assemble().toHex(), "5b" "6000" "56" "610133" + padding + "5b");
+}
+
+BOOST_AUTO_TEST_CASE(cse_keeps_equal_unimprovable_chunks_with_their_locations)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	auto sourceName = std::make_shared<std::string>("source.sol");
+	Assembly assembly{evmVersion, false, {}};
+	// Removed by the first iteration, so that the chunks below are seen again in the second one.
+	assembly.append(u256(1));
+	assembly.append(u256(2));
+	assembly.append(Instruction::ADD);
+	assembly.append(Instruction::POP);
+	assembly.append(Instruction::STOP);
+	// Equal chunks the common subexpression eliminator cannot shorten.
+	for (int i = 0; i < 3; ++i)
+	{
+		assembly.setSourceLocation({10 * i, 10 * i + 5, sourceName});
+		assembly.append(Instruction::CALLVALUE);
+		assembly.append(u256(0));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::STOP);
+	}
+
+	Assembly::OptimiserSettings settings;
+	settings.evmVersion = evmVersion;
+	settings.runCSE = true;
+	assembly.optimise(settings);
+
+	AssemblyItems expectation{Instruction::STOP};
+	for (int i = 0; i < 3; ++i)
+		expectation += AssemblyItems{Instruction::CALLVALUE, u256(0), Instruction::SSTORE, Instruction::STOP};
+	BOOST_REQUIRE(assembly.items() == expectation);
+	// Chunks that are skipped are copied from the assembly rather than from an earlier equal chunk.
+	for (size_t i = 1; i < assembly.items().size(); ++i)
+		BOOST_CHECK_EQUAL(assembly.items()[i].location().start, 10 * static_cast<int>((i - 1) / 4));
+}
+
+BOOST_AUTO_TEST_CASE(item_data_comparison)
+{
+	u256 const small = std::numeric_limits<uint64_t>::max();
+	u256 const large = small + 1;
+
+	BOOST_CHECK_EQUAL(AssemblyItem(small).data(), small);
+	BOOST_CHECK_EQUAL(AssemblyItem(large).data(), large);
+	BOOST_CHECK(AssemblyItem(large) == AssemblyItem(large));
+	BOOST_CHECK(AssemblyItem(small) != AssemblyItem(large));
+	BOOST_CHECK(AssemblyItem(small) < AssemblyItem(large));
+	BOOST_CHECK(!(AssemblyItem(large) < AssemblyItem(small)));
+	BOOST_CHECK(AssemblyItem(large) < AssemblyItem(large + 1));
+	BOOST_CHECK(AssemblyItem(Tag, 1) != AssemblyItem(PushTag, 1));
+
+	AssemblyItem item(large);
+	item.setData(1);
+	BOOST_CHECK(item == AssemblyItem(u256(1)));
+	item.setData(large);
+	BOOST_CHECK(item == AssemblyItem(large));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
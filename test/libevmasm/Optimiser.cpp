@@ -35,6 +35,7 @@
 
 #include <range/v3/algorithm/any_of.hpp>
 
+#include <random>
 #include <string>
 #include <tuple>
 #include <memory>
@@ -1043,9 +1044,9 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1215,6 +1216,58 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(peephole_long_pop_chain)
+{
+	// Every pass removes one DUP1 POP pair from the middle, so this needs as many passes
+	// as there are pairs.
+	size_t const pairs = 10000;
+	AssemblyItems items{Instruction::CALLVALUE};
+	for (size_t i = 0; i < pairs; ++i)
+		items.emplace_back(Instruction::DUP1);
+	for (size_t i = 0; i < pairs; ++i)
+		items.emplace_back(Instruction::POP);
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	AssemblyItems expectation{Instruction::CALLVALUE};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_equivalent_to_full_passes)
+{
+	std::vector<AssemblyItem> const vocabulary{
+		u256(0), u256(1), u256(2),
+		AssemblyItem(PushTag, 1), AssemblyItem(PushTag, 2),
+		AssemblyItem(Tag, 1), AssemblyItem(Tag, 2),
+		Instruction::POP, Instruction::DUP1, Instruction::DUP2, Instruction::SWAP1, Instruction::SWAP2,
+		Instruction::ADD, Instruction::SUB, Instruction::MUL, Instruction::AND, Instruction::EQ,
+		Instruction::LT, Instruction::GT, Instruction::ISZERO,
+		Instruction::CALLVALUE, Instruction::CALLDATASIZE, Instruction::CALLDATALOAD,
+		Instruction::MSTORE, Instruction::SSTORE,
+		Instruction::JUMP, Instruction::JUMPI, Instruction::STOP, Instruction::RETURN, Instruction::REVERT
+	};
+	std::mt19937 random(1);
+	for (size_t round = 0; round < 2000; ++round)
+	{
+		AssemblyItems items;
+		for (size_t length = random() % 60; length > 0; --length)
+			items.push_back(vocabulary[random() % vocabulary.size()]);
+
+		AssemblyItems reference = items;
+		bool const referenceChanged = PeepholeOptimiser(reference, true).optimise();
+		PeepholeOptimiser peepOpt(items);
+		BOOST_REQUIRE_EQUAL(peepOpt.optimise(), referenceChanged);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			reference.begin(), reference.end()
+		);
+		// The result is a fixed point.
+		BOOST_REQUIRE(!peepOpt.optimise());
+	}
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -1308,6 +1361,70 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jumpdest_removal_sibling_subassemblies_concurrently)
+{
+	// This tests that optimising sibling subassemblies concurrently
+	// gives the same result as optimising them one after another.
+
+	Assembly::OptimiserSettings settings;
+	settings.runInliner = false;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.expectedExecutionsPerDeployment = OptimiserSettings{}.expectedExecutionsPerDeployment;
+
+	auto optimiseMain = [&](size_t _jobs) {
+		Assembly main{settings.evmVersion, false, {}};
+		std::vector<AssemblyPointer> subs;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			AssemblyPointer sub = std::make_shared<Assembly>(settings.evmVersion, true, std::string{});
+			sub->append(u256(1));
+			auto t1 = sub->newTag();
+			sub->append(t1);
+			sub->append(u256(2 + i));
+			sub->append(Instruction::JUMP);
+			auto t2 = sub->newTag();
+			sub->append(t2); // Identical to T1, will be unified
+			sub->append(u256(2 + i));
+			sub->append(Instruction::JUMP);
+			auto t3 = sub->newTag();
+			sub->append(t3); // This will be removed
+			sub->append(u256(7));
+
+			size_t subId = static_cast<size_t>(main.appendSubroutine(sub).data());
+			main.append(t2.toSubAssemblyTag(subId));
+			subs.emplace_back(std::move(sub));
+		}
+
+		settings.jobs = _jobs;
+		main.optimise(settings);
+
+		std::vector<AssemblyItems> items{main.items()};
+		for (AssemblyPointer const& sub: subs)
+			items.emplace_back(sub->items());
+		return items;
+	};
+
+	std::vector<AssemblyItems> sequential = optimiseMain(1);
+	std::vector<AssemblyItems> concurrent = optimiseMain(4);
+	BOOST_REQUIRE_EQUAL(sequential.size(), concurrent.size());
+	for (size_t i = 0; i < sequential.size(); ++i)
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			sequential[i].begin(), sequential[i].end(),
+			concurrent[i].begin(), concurrent[i].end()
+		);
+
+	AssemblyItems expectationSub{u256(1), AssemblyItem(Tag, 1), u256(2), Instruction::JUMP};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		concurrent[1].begin(), concurrent[1].end(),
+		expectationSub.begin(), expectationSub.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -21,9 +21,14 @@
  */
 
 #include <liblangutil/Scanner.h>
+#include <libsolutil/StringUtils.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <map>
+#include <random>
+#include <vector>
+
 using namespace solidity::langutil;
 using namespace std::string_literals;
 
@@ -1026,6 +1031,202 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+namespace
+{
+
+/// The keywords of TOKEN_LIST in a std::map, which is how they used to be looked up.
+std::map<std::string, Token> const& referenceKeywords()
+{
+#define KEYWORD(name, string, precedence) {string, Token::name},
+#define TOKEN(name, string, precedence)
+	static std::map<std::string, Token> const keywords{TOKEN_LIST(TOKEN, KEYWORD)};
+#undef KEYWORD
+#undef TOKEN
+	return keywords;
+}
+
+Token referenceKeywordByName(std::string const& _name)
+{
+	auto it = referenceKeywords().find(_name);
+	return it == referenceKeywords().end() ? Token::Identifier : it->second;
+}
+
+/// @returns the token the scanner in mode @a _kind returns for a keyword or identifier
+/// that is @a _token in Solidity.
+Token tokenInMode(ScannerKind _kind, std::string const& _literal, Token _token)
+{
+	if (_kind == ScannerKind::Solidity && TokenTraits::isExperimentalSolidityOnlyKeyword(_token))
+		return Token::Identifier;
+	if (_kind == ScannerKind::Yul)
+	{
+		if (_literal == "leave")
+			return Token::Leave;
+		if (!TokenTraits::isYulKeyword(_token))
+			return Token::Identifier;
+	}
+	return _token;
+}
+
+struct ExpectedToken
+{
+	Token token;
+	std::string literal;
+	int start;
+	int end;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(keyword_lookup_equivalence)
+{
+	BOOST_REQUIRE(!referenceKeywords().empty());
+	for (auto const& [name, token]: referenceKeywords())
+	{
+		BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword(name)), token);
+		// Names close to keywords hash to other slots or collide with them.
+		std::vector<std::string> variants{
+			name + "x",
+			name + "_",
+			"_" + name,
+			name.substr(0, name.size() - 1),
+			name.substr(1),
+			std::string(1, static_cast<char>(std::toupper(name[0]))) + name.substr(1),
+			name + name
+		};
+		for (std::string const& variant: variants)
+			if (!variant.empty() && !util::isDigit(variant[0]))
+				BOOST_CHECK_MESSAGE(
+					std::get<0>(TokenTraits::fromIdentifierOrKeyword(variant)) == referenceKeywordByName(variant),
+					"Lookup of \"" + variant + "\" differs."
+				);
+	}
+	BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("x")), Token::Identifier);
+	BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword(std::string(100, 'a'))), Token::Identifier);
+}
+
+BOOST_AUTO_TEST_CASE(sized_elementary_type_names)
+{
+	for (int m = 0; m <= 300; ++m)
+	{
+		std::string const size = std::to_string(m);
+		bool const validInt = 0 < m && m <= 256 && m % 8 == 0;
+		bool const validBytes = 0 < m && m <= 32;
+		BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("uint" + size) == std::make_tuple(validInt ? Token::UIntM : Token::Identifier, validInt ? m : 0, 0u));
+		BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("int" + size) == std::make_tuple(validInt ? Token::IntM : Token::Identifier, validInt ? m : 0, 0u));
+		BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("bytes" + size) == std::make_tuple(validBytes ? Token::BytesM : Token::Identifier, validBytes ? m : 0, 0u));
+		BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("uint" + size + "a")), Token::Identifier);
+		BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("address" + size)), Token::Identifier);
+		BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("x" + size)), Token::Identifier);
+	}
+	for (int n = 0; n <= 90; n += 9)
+	{
+		bool const valid = n <= 80;
+		BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("fixed128x" + std::to_string(n)) == std::make_tuple(valid ? Token::FixedMxN : Token::Identifier, valid ? 128u : 0u, valid ? unsigned(n) : 0u));
+		BOOST_CHECK(TokenTraits::fromIdentifierOrKeyword("ufixed8x" + std::to_string(n)) == std::make_tuple(valid ? Token::UFixedMxN : Token::Identifier, valid ? 8u : 0u, valid ? unsigned(n) : 0u));
+	}
+	BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("fixed12x8")), Token::Identifier);
+	BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("fixed128x")), Token::Identifier);
+	BOOST_CHECK_EQUAL(std::get<0>(TokenTraits::fromIdentifierOrKeyword("fixedx8")), Token::Identifier);
+}
+
+BOOST_AUTO_TEST_CASE(comment_ends)
+{
+	TestScanner scanner("a // comment * / \xc2\xa0\n b /* x ** / * */ c /* ***/ d // end");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "d");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+
+	scanner.reset("a /* never closed ** /");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalCommentTerminator);
+
+	scanner.reset("a // comment\r\nb//\rc");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(random_token_streams)
+{
+	// Joins random tokens with random whitespace and comments and checks that the
+	// scanner returns exactly those tokens with their literals and locations.
+	std::mt19937 random(1);
+	std::vector<std::string> keywords;
+	for (auto const& [name, token]: referenceKeywords())
+		if (name != "hex" && name != "unicode")
+			keywords.push_back(name);
+	std::vector<std::string> const separators{
+		" ", "\t", "\n", "\r\n", "  \t \n  ",
+		"// comment with * and / \n", "//\n",
+		"/* comment */", "/* a * b ** / * c */", "/***/", "/*\n * line\n */"
+	};
+	std::string const identifierStart = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_$";
+	std::string const identifierPart = identifierStart + "0123456789";
+
+	for (ScannerKind kind: {ScannerKind::Solidity, ScannerKind::Yul})
+		for (size_t round = 0; round < 300; ++round)
+		{
+			std::string source;
+			std::vector<ExpectedToken> expectation;
+			size_t const count = random() % 20;
+			for (size_t i = 0; i < count; ++i)
+			{
+				source += separators[random() % separators.size()];
+				std::string text;
+				Token token = Token::Identifier;
+				switch (random() % 4)
+				{
+				case 0:
+					text = keywords[random() % keywords.size()];
+					token = referenceKeywordByName(text);
+					break;
+				case 1:
+					text = "uint" + std::to_string(8 * (1 + random() % 32));
+					token = Token::UIntM;
+					break;
+				default:
+					// No keyword starts with 'x'.
+					text = "x";
+					for (size_t length = random() % 40; length > 0; --length)
+					{
+						text += identifierPart[random() % identifierPart.size()];
+						if (kind == ScannerKind::Yul && random() % 8 == 0)
+							text += ".";
+					}
+					break;
+				}
+				int const start = static_cast<int>(source.size());
+				source += text;
+				token = tokenInMode(kind, text, token);
+				expectation.push_back({token, text, start, static_cast<int>(source.size())});
+				// Keep the tokens apart.
+				source += separators[random() % separators.size()];
+			}
+
+			TestScanner scanner(source);
+			scanner.scanner->setScannerMode(kind);
+			for (ExpectedToken const& expected: expectation)
+			{
+				BOOST_REQUIRE_MESSAGE(scanner.currentToken() == expected.token, "Unexpected token in: " + source);
+				if (expected.token == Token::Identifier || expected.token == Token::UIntM)
+					BOOST_REQUIRE_EQUAL(scanner.currentLiteral(), expected.literal);
+				BOOST_REQUIRE_EQUAL(scanner.currentLocation().start, expected.start);
+				BOOST_REQUIRE_EQUAL(scanner.currentLocation().end, expected.end);
+				scanner.next();
+			}
+			BOOST_REQUIRE_MESSAGE(scanner.currentToken() == Token::EOS, "Expected end of input in: " + source);
+		}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
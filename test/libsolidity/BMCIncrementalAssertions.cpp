@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for keeping the assertions of BMC queries in solver scopes across queries.
+ */
+
+#include <libsolidity/formal/BMC.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace solidity::smtutil;
+using Assertions = solidity::frontend::smt::EncodingContext::Assertions;
+using AssertionNode = solidity::frontend::smt::EncodingContext::AssertionNode;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Solver that only records the names of the assertions of each of its scopes.
+class RecordingSolver: public SolverInterface
+{
+public:
+	void reset() override { m_scopes = {{}}; }
+	void push() override { m_scopes.emplace_back(); }
+	void pop() override
+	{
+		BOOST_REQUIRE(m_scopes.size() > 1);
+		m_scopes.pop_back();
+	}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(smtutil::Expression const& _expression) override
+	{
+		m_scopes.back().push_back(_expression.name);
+		++m_addedAssertions;
+	}
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<smtutil::Expression> const&) override
+	{
+		return {CheckResult::ERROR, {}};
+	}
+
+	/// @returns the names of all asserted expressions, the earliest first.
+	std::vector<std::string> assertions() const
+	{
+		std::vector<std::string> names;
+		for (auto const& scope: m_scopes)
+			names.insert(names.end(), scope.begin(), scope.end());
+		return names;
+	}
+	size_t scopes() const { return m_scopes.size() - 1; }
+	size_t addedAssertions() const { return m_addedAssertions; }
+
+private:
+	std::vector<std::vector<std::string>> m_scopes{{}};
+	size_t m_addedAssertions = 0;
+};
+
+Assertions append(Assertions const& _list, std::string const& _name)
+{
+	size_t depth = _list ? _list->depth + 1 : 1;
+	return std::make_shared<AssertionNode const>(AssertionNode{smtutil::Expression(_name, {}, SortProvider::boolSort), _list, depth});
+}
+
+std::vector<std::string> names(Assertions const& _list)
+{
+	std::vector<std::string> result;
+	for (auto const* node = _list.get(); node; node = node->previous.get())
+		result.insert(result.begin(), node->assertion.name);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BMCIncrementalAssertions)
+
+BOOST_AUTO_TEST_CASE(only_new_assertions_are_added)
+{
+	RecordingSolver solver;
+	BMC::SolverScopes scopes;
+	Assertions ab = append(append(nullptr, "a"), "b");
+	Assertions abc = append(ab, "c");
+
+	BMC::assertIncrementally(solver, scopes, ab);
+	BOOST_CHECK(solver.assertions() == names(ab));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 2);
+
+	// Asserting the same list again does nothing.
+	BMC::assertIncrementally(solver, scopes, ab);
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 2);
+	BOOST_CHECK_EQUAL(solver.scopes(), 1);
+
+	BMC::assertIncrementally(solver, scopes, abc);
+	BOOST_CHECK(solver.assertions() == names(abc));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 3);
+	BOOST_CHECK_EQUAL(solver.scopes(), 2);
+
+	// Going back to the shorter list only pops the scope of c.
+	BMC::assertIncrementally(solver, scopes, ab);
+	BOOST_CHECK(solver.assertions() == names(ab));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 3);
+	BOOST_CHECK_EQUAL(solver.scopes(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(other_branch_keeps_common_scopes)
+{
+	RecordingSolver solver;
+	BMC::SolverScopes scopes;
+	Assertions ab = append(append(nullptr, "a"), "b");
+	Assertions abc = append(ab, "c");
+	Assertions abd = append(ab, "d");
+
+	BMC::assertIncrementally(solver, scopes, ab);
+	BMC::assertIncrementally(solver, scopes, abc);
+	BMC::assertIncrementally(solver, scopes, abd);
+	BOOST_CHECK(solver.assertions() == names(abd));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 4);
+	BOOST_CHECK_EQUAL(solver.scopes(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(scope_with_assertions_of_other_branch_is_replaced)
+{
+	RecordingSolver solver;
+	BMC::SolverScopes scopes;
+	Assertions ab = append(append(nullptr, "a"), "b");
+	Assertions abc = append(ab, "c");
+	Assertions abd = append(ab, "d");
+
+	// a, b and c are added in one scope, which cannot be kept for the other branch.
+	BMC::assertIncrementally(solver, scopes, abc);
+	BMC::assertIncrementally(solver, scopes, abd);
+	BOOST_CHECK(solver.assertions() == names(abd));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 6);
+	BOOST_CHECK_EQUAL(solver.scopes(), 1);
+
+	// Equal assertions in different nodes are not shared.
+	Assertions otherAb = append(append(nullptr, "a"), "b");
+	BMC::assertIncrementally(solver, scopes, otherAb);
+	BOOST_CHECK(solver.assertions() == names(otherAb));
+	BOOST_CHECK_EQUAL(solver.addedAssertions(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(random_paths)
+{
+	// Walks a random tree of assertion lists the way the encoding context creates them
+	// and checks that the solver always holds exactly the requested assertions.
+	std::mt19937 random(1);
+	RecordingSolver solver;
+	BMC::SolverScopes scopes;
+	std::vector<Assertions> stack{nullptr};
+	size_t nextName = 0;
+	for (size_t step = 0; step < 2000; ++step)
+	{
+		switch (random() % 4)
+		{
+		case 0:
+			stack.push_back(stack.back());
+			break;
+		case 1:
+			if (stack.size() > 1)
+				stack.pop_back();
+			break;
+		default:
+			stack.back() = append(stack.back(), "x" + std::to_string(nextName++));
+			break;
+		}
+		if (random() % 2)
+		{
+			BMC::assertIncrementally(solver, scopes, stack.back());
+			BOOST_REQUIRE(solver.assertions() == names(stack.back()));
+			BOOST_REQUIRE_EQUAL(solver.scopes(), scopes.size());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,225 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for querying the solvers of the SMT portfolio concurrently.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Solver that answers every query with the same result after a delay.
+class FakeSolver: public SolverInterface
+{
+public:
+	FakeSolver(
+		CheckResult _result,
+		std::chrono::milliseconds _delay,
+		std::string _value = {},
+		bool _throwOnAssertion = false
+	):
+		m_result(_result),
+		m_delay(_delay),
+		m_value(std::move(_value)),
+		m_throwOnAssertion(_throwOnAssertion)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override
+	{
+		if (m_throwOnAssertion)
+			throw std::runtime_error("Assertion not supported.");
+	}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override
+	{
+		m_interrupted = false;
+		auto const deadline = std::chrono::steady_clock::now() + m_delay;
+		while (std::chrono::steady_clock::now() < deadline)
+		{
+			if (m_interrupted)
+				return {CheckResult::UNKNOWN, {}};
+			std::this_thread::sleep_for(1ms);
+		}
+		return {m_result, std::vector<std::string>(_expressionsToEvaluate.size(), m_value)};
+	}
+
+	void interrupt() override { m_interrupted = true; }
+
+private:
+	CheckResult m_result;
+	std::chrono::milliseconds m_delay;
+	std::string m_value;
+	bool m_throwOnAssertion;
+	std::atomic<bool> m_interrupted = false;
+};
+
+std::unique_ptr<SMTPortfolio> portfolio(std::vector<std::shared_ptr<FakeSolver>> const& _solvers)
+{
+	// The portfolio owns its solvers, so they are wrapped to be able to inspect them.
+	class SharedSolver: public SolverInterface
+	{
+	public:
+		explicit SharedSolver(std::shared_ptr<FakeSolver> _solver): m_solver(std::move(_solver)) {}
+		void reset() override { m_solver->reset(); }
+		void push() override { m_solver->push(); }
+		void pop() override { m_solver->pop(); }
+		void declareVariable(std::string const& _name, SortPointer const& _sort) override { m_solver->declareVariable(_name, _sort); }
+		void addAssertion(Expression const& _expr) override { m_solver->addAssertion(_expr); }
+		std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressions) override
+		{
+			return m_solver->check(_expressions);
+		}
+		void interrupt() override { m_solver->interrupt(); }
+	private:
+		std::shared_ptr<FakeSolver> m_solver;
+	};
+
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	for (auto const& solver: _solvers)
+		solvers.emplace_back(std::make_unique<SharedSolver>(solver));
+	return std::make_unique<SMTPortfolio>(std::move(solvers));
+}
+
+std::vector<Expression> const expressionsToEvaluate{Expression(size_t(1))};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(answer_of_first_solver_is_used_regardless_of_timing)
+{
+	for (size_t i = 0; i < 5; ++i)
+	{
+		auto solvers = portfolio({
+			std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 50ms, "first"),
+			std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 0ms, "second")
+		});
+		auto [result, values] = solvers->check(expressionsToEvaluate);
+		BOOST_CHECK(result == CheckResult::SATISFIABLE);
+		BOOST_CHECK(values == std::vector<std::string>{"first"});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(answers_without_values_do_not_wait_for_earlier_solvers)
+{
+	auto slowUnsatisfiable = std::make_shared<FakeSolver>(CheckResult::UNSATISFIABLE, 60s);
+	auto slowSatisfiable = std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 60s, "first");
+	auto const start = std::chrono::steady_clock::now();
+
+	auto unsatisfiable = portfolio({slowUnsatisfiable, std::make_shared<FakeSolver>(CheckResult::UNSATISFIABLE, 0ms)});
+	BOOST_CHECK(unsatisfiable->check(expressionsToEvaluate).first == CheckResult::UNSATISFIABLE);
+
+	// Without expressions to evaluate, a satisfiable answer has no values either.
+	auto satisfiable = portfolio({slowSatisfiable, std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 0ms, "second")});
+	auto [result, values] = satisfiable->check({});
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values.empty());
+
+	// The slow solvers have been interrupted, otherwise destroying the portfolios would take a minute.
+	unsatisfiable.reset();
+	satisfiable.reset();
+	BOOST_CHECK(std::chrono::steady_clock::now() - start < 30s);
+}
+
+BOOST_AUTO_TEST_CASE(later_solver_answers_if_earlier_ones_do_not)
+{
+	auto solvers = portfolio({
+		std::make_shared<FakeSolver>(CheckResult::UNKNOWN, 20ms),
+		std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 0ms, "second")
+	});
+	auto [result, values] = solvers->check(expressionsToEvaluate);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"second"});
+
+	auto unknown = portfolio({
+		std::make_shared<FakeSolver>(CheckResult::UNKNOWN, 0ms),
+		std::make_shared<FakeSolver>(CheckResult::ERROR, 0ms)
+	});
+	BOOST_CHECK(unknown->check(expressionsToEvaluate).first == CheckResult::UNKNOWN);
+}
+
+BOOST_AUTO_TEST_CASE(later_solvers_are_interrupted)
+{
+	auto slow = std::make_shared<FakeSolver>(CheckResult::UNSATISFIABLE, 60s);
+	auto solvers = portfolio({
+		std::make_shared<FakeSolver>(CheckResult::UNSATISFIABLE, 0ms),
+		slow
+	});
+	auto const start = std::chrono::steady_clock::now();
+	BOOST_CHECK(solvers->check(expressionsToEvaluate).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(solvers->check(expressionsToEvaluate).first == CheckResult::UNSATISFIABLE);
+	solvers.reset();
+	BOOST_CHECK(std::chrono::steady_clock::now() - start < 30s);
+}
+
+BOOST_AUTO_TEST_CASE(failed_command_is_reported_by_queries_until_reset)
+{
+	auto solvers = portfolio({
+		std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 0ms, "first", true),
+		std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 20ms, "second")
+	});
+	// The exception is not thrown by an unrelated later command.
+	solvers->addAssertion(Expression(true));
+	solvers->push();
+	// The first solver misses the assertion, so its answer must not be used.
+	auto [result, values] = solvers->check(expressionsToEvaluate);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"second"});
+
+	solvers->reset();
+	std::tie(result, values) = solvers->check(expressionsToEvaluate);
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK(values == std::vector<std::string>{"first"});
+}
+
+BOOST_AUTO_TEST_CASE(exception_is_rethrown_if_no_solver_answers)
+{
+	auto solvers = portfolio({
+		std::make_shared<FakeSolver>(CheckResult::SATISFIABLE, 0ms, "first", true),
+		std::make_shared<FakeSolver>(CheckResult::ERROR, 0ms)
+	});
+	solvers->addAssertion(Expression(true));
+	BOOST_CHECK_THROW(solvers->check(expressionsToEvaluate), std::runtime_error);
+	solvers->reset();
+	BOOST_CHECK(solvers->check(expressionsToEvaluate).first == CheckResult::SATISFIABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
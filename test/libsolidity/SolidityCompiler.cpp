@@ -22,6 +22,12 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/codegen/ir/Common.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolutil/TemporaryDirectory.h>
+#include <libyul/YulStack.h>
+#include <libevmasm/Assembly.h>
+
 #include <boost/test/unit_test.hpp>
 
 
@@ -68,6 +74,138 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(via_ir_output_matches_reparsed_optimized_ir)
+{
+	// The optimized IR is assembled directly from the AST that was optimized. This has to give the
+	// same result as printing the optimized IR and assembling it after parsing it again.
+	StringMap const sources = {{"A.sol", R"(
+		contract D {
+			uint public x;
+			constructor(uint _x) { x = _x * 2; }
+		}
+		contract C {
+			function f(uint a) public returns (uint) {
+				D d = new D(a);
+				return d.x() + a;
+			}
+		}
+	)"}};
+
+	for (bool optimize: {false, true})
+		for (langutil::DebugInfoSelection const& debugInfoSelection: {langutil::DebugInfoSelection::None(), langutil::DebugInfoSelection::Default()})
+		{
+			OptimiserSettings const optimiserSettings = optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+			CompilerStack compiler;
+			compiler.setSources(sources);
+			compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+			compiler.setEOFVersion(solidity::test::CommonOptions::get().eofVersion());
+			compiler.setOptimiserSettings(optimiserSettings);
+			compiler.setViaIR(true);
+			compiler.selectDebugInfo(debugInfoSelection);
+			BOOST_REQUIRE(compiler.compile());
+
+			for (std::string const contractName: {"A.sol:C", "A.sol:D"})
+			{
+				yul::YulStack stack(
+					solidity::test::CommonOptions::get().evmVersion(),
+					solidity::test::CommonOptions::get().eofVersion(),
+					yul::YulStack::Language::StrictAssembly,
+					optimiserSettings,
+					debugInfoSelection
+				);
+				BOOST_REQUIRE(stack.parseAndAnalyze("", compiler.yulIROptimized(contractName)));
+				auto [assembly, runtimeAssembly] = stack.assembleEVMWithDeployed(
+					IRNames::deployedObject(compiler.contractDefinition(contractName))
+				);
+
+				BOOST_CHECK(assembly->assemble().bytecode == compiler.object(contractName).bytecode);
+				BOOST_CHECK(runtimeAssembly->assemble().bytecode == compiler.runtimeObject(contractName).bytecode);
+				BOOST_CHECK_EQUAL(
+					assembly->assemblyString(debugInfoSelection, sources),
+					compiler.assemblyString(contractName, sources)
+				);
+				BOOST_CHECK_EQUAL(
+					evmasm::AssemblyItem::computeSourceMapping(assembly->items(), compiler.sourceIndices()),
+					*compiler.sourceMapping(contractName)
+				);
+				BOOST_CHECK_EQUAL(
+					evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly->items(), compiler.sourceIndices()),
+					*compiler.runtimeSourceMapping(contractName)
+				);
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_reused_subobjects_match_optimizing_them_again)
+{
+	// The optimized objects of created contracts replace the subobjects embedding them. This has
+	// to give the same result as optimizing the unoptimized IR of the creating contract as a whole.
+	StringMap const sources = {
+		{"C.sol", R"(
+			contract C {
+				uint public x;
+				constructor(uint _x) { x = _x * 2; }
+				function f(uint a) public view returns (uint) { return x + a; }
+			}
+		)"},
+		{"Factory.sol", R"(
+			import "C.sol";
+			contract Factory {
+				function create(uint a) public returns (address) { return address(new C(a)); }
+				function code() public pure returns (bytes memory) { return type(C).creationCode; }
+			}
+		)"}
+	};
+	std::string const factoryName = "Factory.sol:Factory";
+
+	util::TemporaryDirectory cacheDirectory("solc-subobject-reuse-test-");
+	auto compile = [&](StringMap const& _sources, std::shared_ptr<CompilationCache> _cache) {
+		auto compiler = std::make_unique<CompilerStack>();
+		compiler->setSources(_sources);
+		compiler->setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compiler->setEOFVersion(solidity::test::CommonOptions::get().eofVersion());
+		compiler->setOptimiserSettings(OptimiserSettings::standard());
+		compiler->setViaIR(true);
+		compiler->setCompilationCache(std::move(_cache));
+		BOOST_REQUIRE(compiler->compile());
+		return compiler;
+	};
+	auto checkMatchesOptimizingAgain = [&](CompilerStack const& _compiler) {
+		yul::YulStack stack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			yul::YulStack::Language::StrictAssembly,
+			OptimiserSettings::standard(),
+			langutil::DebugInfoSelection::Default()
+		);
+		BOOST_REQUIRE(stack.parseAndAnalyze("", _compiler.yulIR(factoryName)));
+		stack.optimize();
+		BOOST_CHECK_EQUAL(stack.print(&_compiler), _compiler.yulIROptimized(factoryName));
+		auto [assembly, runtimeAssembly] = stack.assembleEVMWithDeployed(
+			IRNames::deployedObject(_compiler.contractDefinition(factoryName))
+		);
+		BOOST_CHECK(assembly->assemble().bytecode == _compiler.object(factoryName).bytecode);
+		BOOST_CHECK(runtimeAssembly->assemble().bytecode == _compiler.runtimeObject(factoryName).bytecode);
+	};
+
+	auto compiler = compile(sources, nullptr);
+	checkMatchesOptimizingAgain(*compiler);
+
+	// Store both contracts in the cache and change only the factory. C is then served from the
+	// cache without a Yul stack, so its subobject in the factory is optimized in place.
+	compile(sources, std::make_shared<CompilationCache>(cacheDirectory.path()));
+	StringMap changedSources = sources;
+	changedSources["Factory.sol"] += "\ncontract Other {}\n";
+	auto cache = std::make_shared<CompilationCache>(cacheDirectory.path());
+	auto cachedCompiler = compile(changedSources, cache);
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 1);
+	checkMatchesOptimizingAgain(*cachedCompiler);
+
+	auto uncachedCompiler = compile(changedSources, nullptr);
+	BOOST_CHECK_EQUAL(cachedCompiler->yulIROptimized(factoryName), uncachedCompiler->yulIROptimized(factoryName));
+	BOOST_CHECK(cachedCompiler->object(factoryName).bytecode == uncachedCompiler->object(factoryName).bytecode);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
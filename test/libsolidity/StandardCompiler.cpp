@@ -23,15 +23,27 @@
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/filesystem.hpp>
+#include <libsolidity/formal/ModelChecker.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/TemporaryDirectory.h>
+#include <libyul/YulStack.h>
+#include <test/Common.h>
 #include <test/Metadata.h>
+#include <test/TestCaseReader.h>
 
 #include <algorithm>
+#include <fstream>
 #include <set>
+#include <sstream>
+#include <tuple>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1656,6 +1668,593 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].is_object());
 }
 
+BOOST_AUTO_TEST_CASE(jobs_invalid_value)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"jobs": 0,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.jobs\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(jobs_do_not_affect_output)
+{
+	std::string const sources = R"(
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f() public { x = 1; } } contract B { A a = new A(); } contract C { B b = new B(); A a = new A(); function g() public returns (bytes memory) { return type(B).creationCode; } } contract D { function h() public pure returns (uint) { return 42; } }"
+			}
+		},
+	)";
+	auto compileWithJobs = [&](size_t _jobs) {
+		return compile(
+			"{\"language\": \"Solidity\"," + sources +
+			"\"settings\": {"
+				"\"viaIR\": true,"
+				"\"optimizer\": {\"enabled\": true},"
+				"\"jobs\": " + std::to_string(_jobs) + ","
+				"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"evm.deployedBytecode.object\", \"irOptimized\"]}}"
+			"}}"
+		);
+	};
+
+	Json sequentialResult = compileWithJobs(1);
+	Json parallelResult = compileWithJobs(4);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["contracts"]["A.sol"].size() == 4);
+	BOOST_CHECK(sequentialResult == parallelResult);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_do_not_affect_ast)
+{
+	auto compileWithJobs = [&](size_t _jobs) {
+		return compile(R"({
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "import \"B.sol\"; contract A is B { function f() public pure returns (uint) { return g() + 1; } }" },
+				"B.sol": { "content": "import \"C.sol\"; contract B is C { function g() internal pure returns (uint) { return h(); } }" },
+				"C.sol": { "content": "contract C { function h() internal pure returns (uint) { uint x; assembly { x := 7 } return x; } }" },
+				"D.sol": { "content": "struct S { uint a; } function d(S memory s) pure returns (uint) { return s.a; }" }
+			},
+			"settings": {
+				"jobs": )" + std::to_string(_jobs) + R"(,
+				"outputSelection": { "*": { "": ["ast"] } }
+			}
+		})");
+	};
+
+	Json sequentialResult = compileWithJobs(1);
+	Json parallelResult = compileWithJobs(4);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["sources"].size() == 4);
+	BOOST_CHECK(sequentialResult == parallelResult);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_do_not_affect_output_of_semantic_tests)
+{
+	boost::filesystem::path const corpus = solidity::test::CommonOptions::get().testPath / "libsolidity" / "semanticTests";
+	BOOST_REQUIRE(boost::filesystem::is_directory(corpus));
+
+	size_t testCount = 0;
+	for (auto const& entry: boost::filesystem::recursive_directory_iterator(corpus))
+	{
+		if (!boost::filesystem::is_regular_file(entry.path()) || entry.path().extension() != ".sol")
+			continue;
+
+		TestCaseReader reader(entry.path().string());
+		Json input;
+		input["language"] = "Solidity";
+		for (auto const& [name, content]: reader.sources().sources)
+			input["sources"][name]["content"] = content;
+		input["settings"]["viaIR"] = true;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::array({
+			"evm.bytecode.object",
+			"evm.deployedBytecode.object",
+			"irOptimized"
+		});
+
+		auto compileWithJobs = [&](size_t _jobs) {
+			input["settings"]["jobs"] = _jobs;
+			return frontend::StandardCompiler{}.compile(input);
+		};
+		BOOST_CHECK_MESSAGE(
+			compileWithJobs(1) == compileWithJobs(4),
+			"Output depends on the number of jobs: " + entry.path().string()
+		);
+		++testCount;
+	}
+	BOOST_CHECK(testCount > 0);
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_matches_document)
+{
+	std::string const input = R"({
+		"language": "Solidity",
+		"sources": {
+			"a.sol": { "content": "contract B { function f() public {} } contract A is B {}" },
+			"a.sol2": { "content": "contract E { function h() public pure { uint y; } } contract D { uint x; }" },
+			"c.sol": { "content": "interface I { function g() external; }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["abi", "evm.bytecode", "evm.methodIdentifiers", "storageLayout"], "": ["ast"] } }
+		}
+	})";
+	Json inputJson;
+	BOOST_REQUIRE(util::jsonParseStrict(input, inputJson));
+
+	for (util::JsonFormat const& format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		frontend::StandardCompiler compiler({}, format);
+		Json document = compiler.compile(inputJson);
+		BOOST_REQUIRE(containsAtMostWarnings(document));
+		BOOST_REQUIRE(document["contracts"].size() == 3);
+
+		BOOST_REQUIRE(document.contains("errors"));
+
+		std::ostringstream stream;
+		BOOST_CHECK(!compiler.compile(input, stream));
+		BOOST_CHECK_EQUAL(stream.str(), util::jsonPrint(document, format));
+		BOOST_CHECK_EQUAL(compiler.compile(input), util::jsonPrint(document, format));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ir_ast_matches_parsed_ir)
+{
+	// The JSON AST of the unoptimized IR is generated by parsing the IR again, because the
+	// YulStack of the contract is optimized in place. It has to be independent of the other
+	// selected outputs and be the AST of the printed IR.
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] =
+		"contract C { uint x; function f(uint a) public returns (uint) { x += a; return x * 2; } }\n"
+		"contract D { function g() public returns (address) { return address(new C()); } }\n";
+	input["settings"]["viaIR"] = true;
+	input["settings"]["optimizer"]["enabled"] = true;
+
+	std::map<bool, Json> irAstByDebugInfo;
+	for (bool debugInfo: {true, false})
+	{
+		input["settings"]["debug"]["debugInfo"] = debugInfo ? Json::array({"*"}) : Json::array();
+
+		input["settings"]["outputSelection"]["*"]["*"] = Json::array({"irAst"});
+		Json const astOnly = frontend::StandardCompiler{}.compile(input);
+		BOOST_REQUIRE(containsAtMostWarnings(astOnly));
+
+		input["settings"]["outputSelection"]["*"]["*"] = Json::array({"ir", "irAst", "irOptimized", "irOptimizedAst", "evm.bytecode.object"});
+		Json const allOutputs = frontend::StandardCompiler{}.compile(input);
+		BOOST_REQUIRE(containsAtMostWarnings(allOutputs));
+
+		for (std::string const contractName: {"C", "D"})
+		{
+			Json const& contract = allOutputs["contracts"]["a.sol"][contractName];
+			BOOST_REQUIRE(contract["ir"].is_string());
+			BOOST_REQUIRE(contract["irAst"].is_object());
+			BOOST_REQUIRE(contract["irOptimizedAst"].is_object());
+			BOOST_CHECK(contract["irAst"] == astOnly["contracts"]["a.sol"][contractName]["irAst"]);
+			BOOST_CHECK(contract["irAst"] != contract["irOptimizedAst"]);
+
+			yul::YulStack stack(
+				langutil::EVMVersion{},
+				std::nullopt,
+				yul::YulStack::Language::StrictAssembly,
+				OptimiserSettings::none(),
+				debugInfo ? langutil::DebugInfoSelection::All() : langutil::DebugInfoSelection::None()
+			);
+			BOOST_REQUIRE(stack.parseAndAnalyze("", contract["ir"].get<std::string>()));
+			BOOST_CHECK(contract["irAst"] == stack.astJson());
+		}
+		irAstByDebugInfo[debugInfo] = allOutputs["contracts"]["a.sol"]["C"]["irAst"];
+	}
+	// Only the IR with debug info refers to the Solidity source.
+	BOOST_CHECK(irAstByDebugInfo[true] != irAstByDebugInfo[false]);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_not_selectable_from_input)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" }
+		},
+		"settings":
+		{
+			"compilationCache": { "directory": "/tmp/solc-cache" }
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"compilationCache\""));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	auto compileWithCache = [&](std::string const& _returnValue) {
+		solidity::frontend::StandardCompiler compiler;
+		compiler.setCompilationCache(std::make_shared<CompilationCache>(cacheDirectory.path()));
+		std::string output = compiler.compile(
+			"{\"language\": \"Solidity\","
+			"\"sources\": {"
+				"\"A.sol\": {\"content\": \"contract A { uint x; function f() public { x = 1; } } contract B { A a = new A(); }\"},"
+				"\"C.sol\": {\"content\": \"contract C { function g() public pure returns (uint) { return " + _returnValue + "; } }\"}"
+			"},"
+			"\"settings\": {"
+				"\"outputSelection\": {\"*\": {\"*\": [\"*\"]}}"
+			"}}"
+		);
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["compilationCache"].is_object());
+		return result;
+	};
+	auto statistics = [](Json const& _result) {
+		return std::make_tuple(
+			_result["compilationCache"]["hits"].get<size_t>(),
+			_result["compilationCache"]["misses"].get<size_t>(),
+			_result["compilationCache"]["evictions"].get<size_t>()
+		);
+	};
+
+	Json firstResult = compileWithCache("1");
+	BOOST_CHECK(statistics(firstResult) == std::make_tuple(0, 3, 0));
+
+	Json cachedResult = compileWithCache("1");
+	BOOST_CHECK(statistics(cachedResult) == std::make_tuple(3, 0, 0));
+	firstResult.erase("compilationCache");
+	cachedResult.erase("compilationCache");
+	BOOST_CHECK(firstResult == cachedResult);
+
+	Json changedResult = compileWithCache("2");
+	BOOST_CHECK(statistics(changedResult) == std::make_tuple(2, 1, 0));
+	BOOST_CHECK(changedResult["contracts"]["A.sol"] == firstResult["contracts"]["A.sol"]);
+	BOOST_CHECK(changedResult["contracts"]["C.sol"]["C"]["evm"]["bytecode"] != firstResult["contracts"]["C.sol"]["C"]["evm"]["bytecode"]);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_eviction_keeps_other_files)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	std::string const otherEntryName = std::string(64, 'a') + ".json";
+	for (std::string const& name: {"package.json"s, "ABCDEF.json"s, std::string(64, 'A') + ".json", otherEntryName})
+		std::ofstream((cacheDirectory.path() / name).string()) << "{}";
+	BOOST_CHECK(CompilationCache::isEntryName(otherEntryName));
+	BOOST_CHECK(!CompilationCache::isEntryName("package.json"));
+	BOOST_CHECK(!CompilationCache::isEntryName(std::string(64, 'A') + ".json"));
+	BOOST_CHECK(!CompilationCache::isEntryName(std::string(64, 'a') + ".tmp"));
+
+	CompilationCache cache(cacheDirectory.path(), 1);
+	cache.store(util::h256(1), Json::object());
+	BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+	BOOST_CHECK(!boost::filesystem::exists(cacheDirectory.path() / otherEntryName));
+	BOOST_CHECK(boost::filesystem::exists(cacheDirectory.path() / (util::h256(1).hex() + ".json")));
+	BOOST_CHECK(boost::filesystem::exists(cacheDirectory.path() / "package.json"));
+	BOOST_CHECK(boost::filesystem::exists(cacheDirectory.path() / "ABCDEF.json"));
+	BOOST_CHECK(boost::filesystem::exists(cacheDirectory.path() / (std::string(64, 'A') + ".json")));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_evicts_least_recently_used)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	auto exists = [&](util::h256 const& _key) {
+		return boost::filesystem::exists(cacheDirectory.path() / (_key.hex() + ".json"));
+	};
+	{
+		CompilationCache cache(cacheDirectory.path(), 2);
+		cache.store(util::h256(1), Json::object());
+		cache.store(util::h256(2), Json::object());
+		BOOST_CHECK(cache.load(util::h256(1)).has_value());
+		cache.store(util::h256(3), Json::object());
+		BOOST_CHECK(exists(util::h256(1)));
+		BOOST_CHECK(!exists(util::h256(2)));
+		BOOST_CHECK(exists(util::h256(3)));
+		BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+
+		// Invalidating an entry that has not been loaded does not change the hits.
+		cache.invalidate(util::h256(3));
+		BOOST_CHECK(!exists(util::h256(3)));
+		BOOST_CHECK_EQUAL(cache.statistics().hits, 1);
+		BOOST_CHECK_EQUAL(cache.statistics().misses, 0);
+		BOOST_CHECK(cache.load(util::h256(1)).has_value());
+		cache.invalidate(util::h256(1));
+		BOOST_CHECK_EQUAL(cache.statistics().hits, 1);
+		BOOST_CHECK_EQUAL(cache.statistics().misses, 1);
+		cache.store(util::h256(4), Json::object());
+	}
+
+	// The entries of an earlier run are taken into account when the cache is opened again.
+	{
+		CompilationCache cache(cacheDirectory.path(), 2);
+		cache.store(util::h256(5), Json::object());
+		BOOST_CHECK(exists(util::h256(4)));
+		cache.store(util::h256(6), Json::object());
+		BOOST_CHECK(!exists(util::h256(4)));
+		BOOST_CHECK(exists(util::h256(5)));
+		BOOST_CHECK(exists(util::h256(6)));
+		BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_stores_requested_artifacts)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	auto compileWithCache = [&](std::string const& _outputs) {
+		solidity::frontend::StandardCompiler compiler;
+		compiler.setCompilationCache(std::make_shared<CompilationCache>(cacheDirectory.path()));
+		std::string output = compiler.compile(
+			"{\"language\": \"Solidity\","
+			"\"sources\": {\"A.sol\": {\"content\": \"contract C { function f() public pure returns (uint) { return 1; } }\"}},"
+			"\"settings\": {\"outputSelection\": {\"*\": {\"*\": [" + _outputs + "]}}}}"
+		);
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		return result;
+	};
+	auto statistics = [](Json const& _result) {
+		return std::make_tuple(
+			_result["compilationCache"]["hits"].get<size_t>(),
+			_result["compilationCache"]["misses"].get<size_t>(),
+			_result["compilationCache"]["evictions"].get<size_t>()
+		);
+	};
+	auto cacheEntry = [&]() {
+		std::vector<boost::filesystem::path> entries;
+		for (auto const& file: boost::filesystem::directory_iterator(cacheDirectory.path()))
+			entries.push_back(file.path());
+		BOOST_REQUIRE_EQUAL(entries.size(), 1);
+		Json entry;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(entries.front()), entry));
+		return entry;
+	};
+
+	Json result = compileWithCache("\"evm.bytecode.object\"");
+	BOOST_CHECK(statistics(result) == std::make_tuple(0, 1, 0));
+	Json entry = cacheEntry();
+	BOOST_CHECK(entry.contains("object"));
+	for (std::string const member: {"assembly", "legacyAssembly", "gasEstimates", "sourceMap", "generatedSources"})
+		BOOST_CHECK(!entry.contains(member));
+
+	// The entry lacks the assembly, so it is replaced by a complete one.
+	Json assemblyResult = compileWithCache("\"evm.assembly\"");
+	BOOST_CHECK(statistics(assemblyResult) == std::make_tuple(0, 1, 1));
+	BOOST_CHECK(cacheEntry().contains("assembly"));
+
+	Json cachedAssemblyResult = compileWithCache("\"evm.assembly\"");
+	BOOST_CHECK(statistics(cachedAssemblyResult) == std::make_tuple(1, 0, 0));
+	BOOST_CHECK(!cachedAssemblyResult["contracts"]["A.sol"]["C"]["evm"]["assembly"].get<std::string>().empty());
+	BOOST_CHECK(cachedAssemblyResult["contracts"] == assemblyResult["contracts"]);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_size_warning_of_recompiled_dependency)
+{
+	util::TemporaryDirectory cacheDirectory("solc-compilation-cache-test-");
+	// The runtime code of B exceeds the size limit because of the literal.
+	std::string const bSource =
+		"contract B { function f() public pure returns (bytes memory) { return hex\\\"" +
+		std::string(2 * 0x6000, '0') +
+		"\\\"; } }";
+	auto compileWithCache = [&](std::string const& _returnValue) {
+		solidity::frontend::StandardCompiler compiler;
+		compiler.setCompilationCache(std::make_shared<CompilationCache>(cacheDirectory.path()));
+		std::string output = compiler.compile(
+			"{\"language\": \"Solidity\","
+			"\"sources\": {"
+				"\"A.sol\": {\"content\": \"import \\\"B.sol\\\"; contract A { function g() public returns (B, uint) { return (new B(), " + _returnValue + "); } }\"},"
+				"\"B.sol\": {\"content\": \"" + bSource + "\"}"
+			"},"
+			"\"settings\": {\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\"]}}}}"
+		);
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		return result;
+	};
+	auto sizeWarningsOfB = [](Json const& _result) {
+		size_t count = 0;
+		for (Json const& error: _result["errors"])
+			if (
+				error["errorCode"] == "5574" &&
+				error.contains("sourceLocation") &&
+				error["sourceLocation"]["file"] == "B.sol"
+			)
+				++count;
+		return count;
+	};
+
+	Json result = compileWithCache("1");
+	BOOST_CHECK_EQUAL(result["compilationCache"]["misses"].get<size_t>(), 2);
+	BOOST_CHECK_EQUAL(sizeWarningsOfB(result), 1);
+
+	// B is served from the cache, but compiled again as a dependency of A.
+	result = compileWithCache("2");
+	BOOST_CHECK_EQUAL(result["compilationCache"]["hits"].get<size_t>(), 1);
+	BOOST_CHECK_EQUAL(result["compilationCache"]["misses"].get<size_t>(), 1);
+	BOOST_CHECK_EQUAL(sizeWarningsOfB(result), 1);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache_not_selectable_from_input)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" }
+		},
+		"settings":
+		{
+			"modelChecker": { "engine": "bmc", "cache": "/tmp/solc-smt-cache" }
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"cache\""));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache_hit_after_unrelated_edit)
+{
+	// Only the results of the solvers linked into the compiler are deterministic enough to be stored.
+	if (solidity::test::CommonOptions::get().disableSMT || !ModelChecker::availableSolvers().z3)
+		return;
+
+	util::TemporaryDirectory cacheDirectory("solc-model-checker-cache-test-");
+	auto checkWithCache = [&](std::string const& _parameterName) {
+		solidity::frontend::StandardCompiler compiler;
+		compiler.setSMTQueryCache(std::make_shared<SMTQueryCache>(cacheDirectory.path()));
+		// g is analyzed before f. Renaming its parameter keeps the AST IDs of f, but changes
+		// the names of the variables declared for g.
+		std::string output = compiler.compile(
+			"{\"language\": \"Solidity\","
+			"\"sources\": {\"A.sol\": {\"content\": \"contract C {"
+				" function g(uint " + _parameterName + ") public pure { assert(" + _parameterName + " > 0); }"
+				" function f(uint x, uint y) public pure { require(x > y); assert(x - y > 0); assert(x > 2 * y); }"
+			" }\"}},"
+			"\"settings\": {\"modelChecker\": {\"engine\": \"bmc\", \"solvers\": [\"z3\"], \"targets\": [\"assert\"]}}}"
+		);
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["modelCheckerCache"].is_object());
+		return result;
+	};
+	auto hits = [](Json const& _result) { return _result["modelCheckerCache"]["hits"].get<size_t>(); };
+	auto misses = [](Json const& _result) { return _result["modelCheckerCache"]["misses"].get<size_t>(); };
+
+	Json firstResult = checkWithCache("a");
+	BOOST_CHECK_EQUAL(hits(firstResult), 0);
+	BOOST_CHECK(misses(firstResult) > 0);
+
+	Json cachedResult = checkWithCache("a");
+	BOOST_CHECK_EQUAL(hits(cachedResult), misses(firstResult));
+	BOOST_CHECK_EQUAL(misses(cachedResult), 0);
+	BOOST_CHECK(cachedResult["errors"] == firstResult["errors"]);
+
+	// The queries of g are solved again, the ones of f are still found in the cache.
+	Json editedResult = checkWithCache("b");
+	BOOST_CHECK(hits(editedResult) > 0);
+	BOOST_CHECK(misses(editedResult) > 0);
+	BOOST_CHECK_EQUAL(hits(editedResult) + misses(editedResult), misses(firstResult));
+	BOOST_CHECK_EQUAL(
+		editedResult["errors"].size(),
+		firstResult["errors"].size()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache_hit_after_earlier_function_edited)
+{
+	// Only the results of the solvers linked into the compiler are deterministic enough to be stored.
+	if (solidity::test::CommonOptions::get().disableSMT || !ModelChecker::availableSolvers().z3)
+		return;
+
+	// Every statement added to g shifts the AST IDs of f, which is in a later source unit.
+	std::string const untouched =
+		"contract C { function f(uint x, uint y) public pure { require(x > y); assert(x - y > 0); assert(x > 2 * y); } }";
+	auto sourceOfD = [](std::string const& _body) {
+		return "contract D { function g(uint a) public pure { " + _body + " } }";
+	};
+	for (std::string const engine: {"bmc", "chc"})
+	{
+		util::TemporaryDirectory cacheDirectory("solc-model-checker-cache-test-");
+		auto checkWithCache = [&](std::map<std::string, std::string> const& _sources) {
+			Json input{
+				{"language", "Solidity"},
+				{"sources", Json::object()},
+				{"settings", {{"modelChecker", {{"engine", engine}, {"solvers", {"z3"}}, {"targets", {"assert"}}}}}}
+			};
+			for (auto const& [name, content]: _sources)
+				input["sources"][name]["content"] = content;
+			solidity::frontend::StandardCompiler compiler;
+			compiler.setSMTQueryCache(std::make_shared<SMTQueryCache>(cacheDirectory.path()));
+			Json result;
+			BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(util::jsonCompactPrint(input)), result));
+			BOOST_REQUIRE(containsAtMostWarnings(result));
+			BOOST_REQUIRE(result["modelCheckerCache"].is_object());
+			return result;
+		};
+		auto hits = [](Json const& _result) { return _result["modelCheckerCache"]["hits"].get<size_t>(); };
+		auto misses = [](Json const& _result) { return _result["modelCheckerCache"]["misses"].get<size_t>(); };
+		auto errorsIn = [](Json const& _result, std::string const& _source) {
+			Json errors = Json::array();
+			for (Json const& error: _result["errors"])
+				if (error.contains("sourceLocation") && error["sourceLocation"]["file"] == _source)
+					errors.emplace_back(error);
+			return errors;
+		};
+
+		BOOST_TEST_MESSAGE("Engine: " + engine);
+		Json onlyC = checkWithCache({{"B.sol", untouched}});
+		BOOST_CHECK_EQUAL(hits(onlyC), 0);
+		BOOST_REQUIRE(misses(onlyC) > 0);
+		BOOST_REQUIRE(!errorsIn(onlyC, "B.sol").empty());
+
+		// All queries of C are found in the cache, even though their symbols are named differently.
+		Json withD = checkWithCache({{"A.sol", sourceOfD("assert(a > 0);")}, {"B.sol", untouched}});
+		BOOST_CHECK_EQUAL(hits(withD), misses(onlyC));
+		BOOST_CHECK(misses(withD) > 0);
+		BOOST_CHECK(errorsIn(withD, "B.sol") == errorsIn(onlyC, "B.sol"));
+
+		Json editedD = checkWithCache({{"A.sol", sourceOfD("a += 1; assert(a > 1);")}, {"B.sol", untouched}});
+		BOOST_CHECK(hits(editedD) >= misses(onlyC));
+		BOOST_CHECK(misses(editedD) > 0);
+		BOOST_CHECK(errorsIn(editedD, "B.sol") == errorsIn(onlyC, "B.sol"));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	auto compileWithOutputs = [&](std::string const& _outputs) {
+		Json result = compile(
+			"{\"language\": \"Solidity\","
+			"\"sources\": {\"A.sol\": {\"content\": \"contract C { uint x; function f(uint a) public { x = a + 0; } }\"}},"
+			"\"settings\": {"
+				"\"optimizer\": {\"enabled\": true},"
+				"\"outputSelection\": {\"*\": {\"*\": [" + _outputs + "]}}"
+			"}}"
+		);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		return result["contracts"]["A.sol"]["C"];
+	};
+
+	Json contract = compileWithOutputs("\"irOptimized\", \"optimizerProfile\"");
+	BOOST_REQUIRE(contract["optimizerProfile"].is_object());
+	Json const& profile = contract["optimizerProfile"];
+	BOOST_REQUIRE(profile["steps"].is_array());
+	BOOST_REQUIRE(!profile["steps"].empty());
+	for (Json const& step: profile["steps"])
+	{
+		BOOST_CHECK(step["object"].is_string());
+		BOOST_CHECK(step["step"].is_string());
+		BOOST_CHECK(step["duration"].get<int64_t>() >= 0);
+		if (step["skipped"].get<bool>())
+			BOOST_CHECK(step["codeSizeBefore"] == step["codeSizeAfter"]);
+	}
+	BOOST_CHECK(profile["totals"].contains("ExpressionSimplifier"));
+	BOOST_REQUIRE(profile["traceEvents"].is_array());
+	BOOST_CHECK(!profile["traceEvents"].empty());
+	for (Json const& event: profile["traceEvents"])
+		BOOST_CHECK(event["ph"] == "X");
+
+	// The profile is not deterministic, so it is not selected by the wildcard.
+	BOOST_CHECK(!compileWithOutputs("\"*\"").contains("optimizerProfile"));
+	// The profile alone does not cause the IR to be generated and optimized.
+	BOOST_CHECK(!compileWithOutputs("\"optimizerProfile\"").contains("optimizerProfile"));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
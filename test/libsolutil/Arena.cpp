@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+bool isAligned(void const* _pointer, size_t _alignment)
+{
+	return reinterpret_cast<uintptr_t>(_pointer) % _alignment == 0;
+}
+
+struct Node
+{
+	Node(std::string _name, size_t& _destroyed): name(std::move(_name)), destroyed(_destroyed) {}
+	~Node() { ++destroyed; }
+
+	std::string name;
+	std::vector<std::shared_ptr<Node>> children;
+	size_t& destroyed;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ArenaTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(alignment)
+{
+	Arena arena;
+	for (size_t alignment: {1, 2, 4, 8, 16, 64, 256})
+		for (size_t size: {1, 3, 8, 17})
+			BOOST_CHECK(isAligned(arena.allocate(size, alignment), alignment));
+}
+
+BOOST_AUTO_TEST_CASE(allocations_do_not_overlap)
+{
+	Arena arena;
+	std::vector<std::pair<std::byte*, size_t>> allocations;
+	// Enough allocations to span several blocks.
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		size_t size = 1 + i % 29;
+		auto* memory = static_cast<std::byte*>(arena.allocate(size, 8));
+		std::memset(memory, static_cast<int>(i % 256), size);
+		allocations.emplace_back(memory, size);
+	}
+	for (size_t i = 0; i < allocations.size(); ++i)
+		for (size_t j = 0; j < allocations[i].second; ++j)
+			BOOST_REQUIRE(allocations[i].first[j] == static_cast<std::byte>(i % 256));
+}
+
+BOOST_AUTO_TEST_CASE(large_allocation)
+{
+	Arena arena;
+	void* small = arena.allocate(16, 8);
+	size_t const largeSize = 1024 * 1024;
+	auto* large = static_cast<std::byte*>(arena.allocate(largeSize, 64));
+	BOOST_CHECK(isAligned(large, 64));
+	std::memset(large, 0xff, largeSize);
+	void* next = arena.allocate(16, 8);
+	BOOST_CHECK(small != next);
+	BOOST_CHECK(next < large || next >= large + largeSize);
+}
+
+BOOST_AUTO_TEST_CASE(allocator_equality)
+{
+	auto arena = std::make_shared<Arena>();
+	ArenaAllocator<int> allocator(arena);
+	ArenaAllocator<double> rebound(allocator);
+	BOOST_CHECK(rebound.arena() == arena);
+	BOOST_CHECK(allocator == rebound);
+	BOOST_CHECK(allocator != ArenaAllocator<int>(std::make_shared<Arena>()));
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_run_destructors)
+{
+	size_t destroyed = 0;
+	{
+		ArenaAllocator<Node> allocator(std::make_shared<Arena>());
+		auto root = std::allocate_shared<Node>(allocator, "root", destroyed);
+		for (size_t i = 0; i < 100; ++i)
+			root->children.emplace_back(std::allocate_shared<Node>(allocator, std::string(40, 'x'), destroyed));
+		std::weak_ptr<Node> child = root->children.front();
+		BOOST_CHECK_EQUAL(root->children.back()->name, std::string(40, 'x'));
+		root.reset();
+		BOOST_CHECK(child.expired());
+	}
+	BOOST_CHECK_EQUAL(destroyed, 101);
+}
+
+BOOST_AUTO_TEST_CASE(objects_keep_arena_alive)
+{
+	size_t destroyed = 0;
+	std::weak_ptr<Arena> arena;
+	std::shared_ptr<Node> child;
+	std::weak_ptr<Node> weakChild;
+	{
+		auto sharedArena = std::make_shared<Arena>();
+		arena = sharedArena;
+		auto root = std::allocate_shared<Node>(ArenaAllocator<Node>(std::move(sharedArena)), "root", destroyed);
+		root->children.emplace_back(std::allocate_shared<Node>(ArenaAllocator<Node>(arena.lock()), "child", destroyed));
+		child = root->children.front();
+		weakChild = child;
+	}
+	// The root is gone, but the child that outlived it is still valid.
+	BOOST_CHECK_EQUAL(destroyed, 1);
+	BOOST_CHECK(!arena.expired());
+	BOOST_CHECK_EQUAL(child->name, "child");
+
+	// A weak pointer needs the control block, which lives in the arena.
+	child.reset();
+	BOOST_CHECK_EQUAL(destroyed, 2);
+	BOOST_CHECK(weakChild.expired());
+	BOOST_CHECK(!arena.expired());
+	weakChild.reset();
+	BOOST_CHECK(arena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -117,6 +119,80 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK(R"({"1":1,"2":"2","3":{"3.1":"3.1","3.2":2},"4":"\u0911 \u0912 \u0913 \u0914 \u0915 \u0916","5":"\u0010","6":"\u4e2d"})" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_writer)
+{
+	Json json;
+	json["1"] = 1;
+	json["2"]["2.1"] = Json::array({1, "2"});
+	json["2"]["2.2"]["2.2.1"] = "\n";
+	json["3"] = Json::object();
+	json["4"] = "ऑ ऒ";
+
+	auto write = [](JsonWriter& _writer) {
+		_writer.write("1", 1);
+		_writer.beginObject("2");
+		_writer.write("2.1", Json::array({1, "2"}));
+		_writer.beginObject("2.2");
+		_writer.write("2.2.1", "\n");
+		_writer.endObject();
+		_writer.beginObject("2.3");
+		_writer.endObject();
+		_writer.endObject();
+		_writer.beginObject("3", true);
+		_writer.endObject();
+		_writer.write("4", "ऑ ऒ");
+		_writer.finish();
+	};
+
+	for (JsonFormat const& format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::ostringstream stream;
+		JsonWriter streamWriter(stream, format);
+		write(streamWriter);
+		BOOST_CHECK_EQUAL(stream.str(), jsonPrint(json, format));
+	}
+
+	Json document;
+	JsonWriter documentWriter(document);
+	write(documentWriter);
+	BOOST_CHECK(document == json);
+
+	std::ostringstream stream;
+	JsonWriter emptyWriter(stream, JsonFormat{JsonFormat::Pretty});
+	emptyWriter.beginObject("1");
+	emptyWriter.endObject();
+	emptyWriter.finish();
+	BOOST_CHECK_EQUAL(stream.str(), "{}");
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_discard)
+{
+	std::ostringstream stream;
+	JsonWriter streamWriter(stream, JsonFormat{JsonFormat::Compact});
+	streamWriter.beginObject("a");
+	streamWriter.write("b", 1);
+	streamWriter.beginObject("c");
+	BOOST_CHECK(streamWriter.hasMember("a"));
+	BOOST_CHECK(!streamWriter.hasMember("b"));
+	// Printed members stay, open objects are closed.
+	streamWriter.discard();
+	BOOST_CHECK(streamWriter.hasMember("a"));
+	streamWriter.write("d", 2);
+	streamWriter.finish();
+	BOOST_CHECK_EQUAL(stream.str(), "{\"a\":{\"b\":1},\"d\":2}");
+
+	Json document;
+	JsonWriter documentWriter(document);
+	documentWriter.beginObject("a");
+	documentWriter.write("b", 1);
+	BOOST_CHECK(documentWriter.hasMember("a"));
+	documentWriter.discard();
+	BOOST_CHECK(!documentWriter.hasMember("a"));
+	documentWriter.write("d", 2);
+	documentWriter.finish();
+	BOOST_CHECK((document == Json{{"d", 2}}));
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
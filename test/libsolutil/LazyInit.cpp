@@ -86,6 +86,15 @@ BOOST_AUTO_TEST_CASE(init_returns_init_value)
 	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 12);
 }
 
+BOOST_AUTO_TEST_CASE(value_or_compute_does_not_initialize)
+{
+	LazyInit<int const> lazyInit;
+
+	BOOST_CHECK_EQUAL(lazyInit.valueOrCompute([]{ return 12; }), 12);
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 42);
+	BOOST_CHECK_EQUAL(lazyInit.valueOrCompute([]{ return 12; }), 42);
+}
+
 BOOST_AUTO_TEST_CASE(moved_from_is_empty)
 {
 	{
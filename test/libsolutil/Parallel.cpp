@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest)
+
+BOOST_AUTO_TEST_CASE(runs_every_task_once)
+{
+	for (size_t jobs: {0, 1, 2, 8})
+	{
+		std::vector<std::atomic<size_t>> calls(100);
+		parallelFor(calls.size(), jobs, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_smallest_index)
+{
+	for (size_t jobs: {1, 4})
+	{
+		std::atomic<size_t> calls{0};
+		try
+		{
+			parallelFor(20, jobs, [&](size_t _index) {
+				++calls;
+				if (_index == 7 || _index == 13)
+					throw std::runtime_error(std::to_string(_index));
+			});
+			BOOST_FAIL("Exception expected.");
+		}
+		catch (std::runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(std::string(_error.what()), "7");
+		}
+		// Without threads, the first exception stops the loop.
+		BOOST_CHECK_EQUAL(calls.load(), jobs == 1 ? 8 : 20);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	std::vector<std::atomic<size_t>> calls(16 * 16);
+	parallelFor(16, 4, [&](size_t _outer) {
+		parallelFor(16, 4, [&](size_t _inner) { ++calls[_outer * 16 + _inner]; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(threads_are_reused)
+{
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	for (size_t run = 0; run < 20; ++run)
+		parallelFor(8, 4, [&](size_t) {
+			std::lock_guard lock(mutex);
+			threads.insert(std::this_thread::get_id());
+		});
+	// The calling thread and at most the threads of the pool that have been
+	// created by this or earlier tests.
+	BOOST_CHECK(threads.size() <= 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for skipping unchanged code in the optimiser suite.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+std::string const source = R"({
+	{
+		sstore(0, f(calldataload(0)))
+		sstore(1, g(calldataload(1)))
+		sstore(2, h(calldataload(2)))
+	}
+	function f(a) -> r { r := add(a, 0) }
+	function g(a) -> r { let x := mload(a) r := add(mload(a), x) }
+	function h(a) -> r { let x := mload(a) r := add(g(a), mload(a)) }
+	function k(a) -> r { let x := mload(a) sstore(a, x) r := add(mload(a), x) }
+})";
+
+class ChangeTrackingFixture
+{
+protected:
+	/// Runs @a Step on the AST with change tracking and on the reference without it.
+	/// @returns the number of statements skipped on the AST.
+	template <typename Step>
+	size_t run()
+	{
+		Step::run(m_context, m_reference);
+
+		StatementChangeTracking tracking{m_statementHashes, m_unchangedStatements};
+		m_context.changeTracking = &tracking;
+		Step::run(m_context, m_ast);
+		m_context.changeTracking = nullptr;
+		BOOST_REQUIRE(tracking.hashesUpdated);
+		BOOST_REQUIRE(m_statementHashes == StatementHasher::run(m_ast));
+		BOOST_CHECK_EQUAL(AsmPrinter{}(m_ast), AsmPrinter{}(m_reference));
+		return tracking.skippedStatements;
+	}
+
+	/// Exchanges the bodies of the functions at the given indices in the AST and in the reference.
+	void swapBodies(size_t _first, size_t _second)
+	{
+		for (Block* ast: {&m_ast, &m_reference})
+			std::swap(
+				std::get<FunctionDefinition>(ast->statements[_first]).body,
+				std::get<FunctionDefinition>(ast->statements[_second]).body
+			);
+		m_statementHashes = StatementHasher::run(m_ast);
+	}
+
+	Dialect const& m_dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block m_ast = disambiguate(source, false);
+	Block m_reference = disambiguate(source, false);
+	std::set<YulString> m_reservedIdentifiers;
+	NameDispenser m_dispenser{m_dialect, m_ast, m_reservedIdentifiers};
+	OptimiserStepContext m_context{m_dialect, m_dispenser, m_reservedIdentifiers, 200};
+	std::vector<uint64_t> m_statementHashes = StatementHasher::run(m_ast);
+	std::set<std::pair<uint64_t, uint64_t>> m_unchangedStatements;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_FIXTURE_TEST_CASE(unchanged_functions_are_skipped, ChangeTrackingFixture)
+{
+	// Only f is changed by the first run.
+	BOOST_CHECK_EQUAL(run<ExpressionSimplifier>(), 0);
+	// The second run only processes f, which does not change anymore.
+	BOOST_CHECK_EQUAL(run<ExpressionSimplifier>(), 4);
+	BOOST_CHECK_EQUAL(run<ExpressionSimplifier>(), 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(changed_side_effects_invalidate_skipping, ChangeTrackingFixture)
+{
+	size_t skipped = run<CommonSubexpressionEliminator>();
+	BOOST_CHECK_EQUAL(skipped, 0);
+	for (size_t i = 0; i < 4 && skipped < 5; ++i)
+		skipped = run<CommonSubexpressionEliminator>();
+	BOOST_CHECK_EQUAL(skipped, 5);
+
+	// Exchanging the bodies of g and k changes the side effects of g, which h depends on,
+	// so all functions are processed again even though only g and k changed.
+	swapBodies(2, 4);
+	BOOST_CHECK_EQUAL(run<CommonSubexpressionEliminator>(), 0);
+	run<CommonSubexpressionEliminator>();
+}
+
+BOOST_AUTO_TEST_CASE(skipping_does_not_change_the_result)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	std::set<YulString> reservedIdentifiers;
+	std::string const sequence =
+		"hgfo dhfoDgvulfnTUtnIf xarrEscLM Vculjj Trpeul xarrcL gvifM CTUcarrLSsTFOtfDncarrIulc "
+		"scCTUt gvifM xscCTUtscCTUt TOntnfDIul gvifM jmuljul VcTOcul jmul";
+	std::vector<std::string> steps;
+	for (size_t round = 0; round < 2; ++round)
+		for (char abbreviation: sequence)
+			if (abbreviation != ' ')
+				steps.emplace_back(OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation));
+
+	// Every step is run by a new suite, which does not know about earlier runs.
+	Block reference = disambiguate(source, false);
+	NameDispenser referenceDispenser{dialect, reference, reservedIdentifiers};
+	OptimiserStepContext referenceContext{dialect, referenceDispenser, reservedIdentifiers, 200};
+	for (std::string const& step: steps)
+		OptimiserSuite{referenceContext}.runSequence(std::vector<std::string>{step}, reference);
+
+	for (size_t jobs: {size_t{1}, size_t{4}})
+	{
+		Block ast = disambiguate(source, false);
+		NameDispenser dispenser{dialect, ast, reservedIdentifiers};
+		OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200, jobs};
+		OptimiserSuite{context}.runSequence(steps, ast);
+		BOOST_CHECK_EQUAL(AsmPrinter{}(ast), AsmPrinter{}(reference));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(equal_strings_are_equal)
+{
+	YulString a("yul_string_test_a");
+	YulString b("yul_string_test_a");
+	YulString c("yul_string_test_c");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "yul_string_test_a");
+	BOOST_CHECK_EQUAL(c.str(), "yul_string_test_c");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("yul_string_test_a"));
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString("") == YulString{});
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t constexpr threadCount = 8;
+	// Large enough to grow the shards and to allocate several blocks of the string storage.
+	size_t constexpr stringCount = 20000;
+
+	auto name = [](size_t _i) {
+		// Long names do not fit into the small string buffer.
+		return "yul_string_concurrent_interning_test_name_" + std::to_string(_i);
+	};
+
+	std::vector<std::vector<YulString>> results(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			results[t].resize(stringCount);
+			// Every thread interns all strings, starting at a different offset,
+			// so that threads race for inserting the same strings.
+			for (size_t i = 0; i < stringCount; ++i)
+			{
+				size_t index = (i + t * stringCount / threadCount) % stringCount;
+				results[t][index] = YulString(name(index));
+			}
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		YulString expected(name(i));
+		BOOST_REQUIRE_EQUAL(expected.str(), name(i));
+		for (size_t t = 0; t < threadCount; ++t)
+		{
+			BOOST_REQUIRE(results[t][i] == expected);
+			BOOST_REQUIRE_EQUAL(results[t][i].hash(), expected.hash());
+			BOOST_REQUIRE_EQUAL(results[t][i].str(), name(i));
+		}
+	}
+	// Distinct strings have distinct IDs.
+	BOOST_CHECK(results[0][0] != results[0][1]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -225,7 +225,7 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
+    def send_message(self, method_name: str, params: Optional[dict], message_id: Optional[int] = None) -> None:
         if self.process.stdin is None:
             return
         message = {
@@ -233,14 +233,22 @@ class JsonRpcProcess:
             'method': method_name,
             'params': params
         }
+        if message_id is not None:
+            message['id'] = message_id
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
         self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
         self.process.stdin.write(rpc_message.encode("utf-8"))
         self.process.stdin.flush()
 
-    def call_method(self, method_name: str, params: Optional[dict], expects_response: bool = True) -> Any:
-        self.send_message(method_name, params)
+    def call_method(
+        self,
+        method_name: str,
+        params: Optional[dict],
+        expects_response: bool = True,
+        message_id: Optional[int] = None
+    ) -> Any:
+        self.send_message(method_name, params, message_id)
         if not expects_response:
             return None
         return self.receive_message()
@@ -1086,6 +1094,28 @@ class SolidityLSPTestSuite: # {{{
         )
         return self.wait_for_diagnostics(solc_process)
 
+    def open_virtual_file(self, solc: JsonRpcProcess, uri: str, text: str) -> None:
+        """
+        Opens a file that does not exist on disk with the given content.
+        """
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': uri,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': text
+            }
+        })
+
+    def replace_virtual_file(self, solc: JsonRpcProcess, uri: str, text: str) -> None:
+        """
+        Replaces the whole content of an opened file.
+        """
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': uri },
+            'contentChanges': [ { 'text': text } ]
+        })
+
     def expect_true(
         self,
         actual,
@@ -1610,6 +1640,174 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 0)
         # The warning went away because the compiler aborts further processing after the error.
 
+    def test_didChange_keeps_diagnostics_of_unaffected_files(self, solc: JsonRpcProcess) -> None:
+        """
+        Only the changed file is analyzed again. The diagnostics of the other file are kept,
+        and it is analyzed again on demand when a request needs its AST.
+        """
+        self.setup_lsp(solc)
+        FILE_A_URI = 'file:///a.sol'
+        FILE_B_URI = 'file:///b.sol'
+        HEADER = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+
+        self.open_virtual_file(solc, FILE_A_URI, HEADER + 'contract A { function f() public pure { uint x; } }\n')
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal([d['code'] for d in reports[0]['diagnostics']], [2072], "unused variable in a.sol")
+
+        self.open_virtual_file(solc, FILE_B_URI, HEADER + 'contract B { function g() public pure { uint y; } }\n')
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 2, "two publish diagnostics notifications")
+        self.expect_equal(reports[0]['uri'], FILE_A_URI, "Correct uri")
+        self.expect_equal([d['code'] for d in reports[0]['diagnostics']], [2072], "a.sol keeps its diagnostics")
+        self.expect_equal([d['code'] for d in reports[1]['diagnostics']], [2072], "unused variable in b.sol")
+
+        self.replace_virtual_file(solc, FILE_A_URI, HEADER + 'contract A { function f() public pure {} }\n')
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 2, "two publish diagnostics notifications")
+        self.expect_equal(len(reports[0]['diagnostics']), 0, "a.sol fixed")
+        self.expect_equal(reports[1]['uri'], FILE_B_URI, "Correct uri")
+        self.expect_equal([d['code'] for d in reports[1]['diagnostics']], [2072], "b.sol keeps its diagnostics")
+        self.expect_diagnostic(reports[1]['diagnostics'][0], 2072, 2, (40, 46))
+
+        # Only a.sol was analyzed last, so b.sol has to be analyzed again to answer the request.
+        response = solc.call_method(
+            'textDocument/semanticTokens/full',
+            { 'textDocument': { 'uri': FILE_B_URI } },
+            message_id=1
+        )
+        self.expect_equal(response['id'], 1, "response to the request")
+        self.expect_true(len(response['result']['data']) > 0, "semantic tokens of b.sol")
+
+    def test_didChange_reanalyzes_importing_files(self, solc: JsonRpcProcess) -> None:
+        """
+        A file importing a changed file is analyzed again, although it did not change itself.
+        """
+        self.setup_lsp(solc)
+        FILE_A_URI = 'file:///a.sol'
+        FILE_B_URI = 'file:///b.sol'
+        HEADER = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+        LIBRARY_WITH_G = HEADER + 'library L { function g() internal pure returns (uint) { return 1; } }\n'
+
+        self.open_virtual_file(solc, FILE_B_URI, LIBRARY_WITH_G)
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+        self.open_virtual_file(
+            solc,
+            FILE_A_URI,
+            HEADER + 'import "./b.sol";\ncontract A { function f() public pure returns (uint) { return L.g(); } }\n'
+        )
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 2, "two publish diagnostics notifications")
+        self.expect_equal(len(reports[0]['diagnostics']), 0, "no diagnostics in a.sol")
+        self.expect_equal(len(reports[1]['diagnostics']), 0, "no diagnostics in b.sol")
+
+        self.replace_virtual_file(solc, FILE_B_URI, HEADER + 'library L {}\n')
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 2, "two publish diagnostics notifications")
+        self.expect_equal(reports[0]['uri'], FILE_A_URI, "Correct uri")
+        self.expect_equal(len(reports[0]['diagnostics']), 1, "a.sol calls the removed function")
+        self.expect_diagnostic(reports[0]['diagnostics'][0], 9582, 3, (62, 65))
+        self.expect_equal(len(reports[1]['diagnostics']), 0, "no diagnostics in b.sol")
+
+        self.replace_virtual_file(solc, FILE_B_URI, LIBRARY_WITH_G)
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 2, "two publish diagnostics notifications")
+        self.expect_equal(len(reports[0]['diagnostics']), 0, "the error in a.sol is gone")
+        self.expect_equal(len(reports[1]['diagnostics']), 0, "no diagnostics in b.sol")
+
+    def test_didChange_burst_is_compiled_once(self, solc: JsonRpcProcess) -> None:
+        """
+        Changes arriving in quick succession are compiled together once no further change
+        arrives for a short time, so only the diagnostics of the last version are published.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///a.sol'
+        HEADER = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+
+        self.open_virtual_file(solc, FILE_URI, HEADER + 'contract C {\n')
+        for text in [
+            'contract C { function f() public pure { uint x = y; } }\n',
+            'contract C { function f() public pure returns (uint) { return 1 + true; } }\n',
+            'contract C { function f() public pure { uint x; } }\n',
+        ]:
+            self.replace_virtual_file(solc, FILE_URI, HEADER + text)
+
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal([d['code'] for d in reports[0]['diagnostics']], [2072], "diagnostics of the last version")
+
+        # Had any of the earlier versions been compiled, its diagnostics would arrive before the response.
+        response = solc.call_method(
+            'textDocument/semanticTokens/full',
+            { 'textDocument': { 'uri': FILE_URI } },
+            message_id=1
+        )
+        self.expect_equal(response.get('id'), 1, "response to the request, no further diagnostics")
+
+    def test_requests_answered_from_last_analysis(self, solc: JsonRpcProcess) -> None:
+        """
+        Hover and semantic tokens requests do not wait for pending changes to be compiled.
+        They are answered from the last analysis, whose diagnostics have been published already.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///a.sol'
+        HEADER = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+        TEXT_DOCUMENT = { 'textDocument': { 'uri': FILE_URI } }
+
+        self.open_virtual_file(solc, FILE_URI, HEADER + 'contract C { function f() public pure returns (uint) { return 1; } }\n')
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports[0]['diagnostics']), 0, "no diagnostics")
+        tokens = solc.call_method('textDocument/semanticTokens/full', TEXT_DOCUMENT, message_id=1)
+
+        self.replace_virtual_file(solc, FILE_URI, HEADER + 'contract D { uint x = y; }\n')
+        response = solc.call_method('textDocument/semanticTokens/full', TEXT_DOCUMENT, message_id=2)
+        self.expect_equal(response.get('id'), 2, "answered before the change is compiled")
+        self.expect_equal(response['result'], tokens['result'], "tokens of the analyzed version")
+
+        response = solc.call_method(
+            'textDocument/hover',
+            { **TEXT_DOCUMENT, 'position': { 'line': 2, 'character': 9 } },
+            message_id=3
+        )
+        self.expect_equal(response.get('id'), 3, "answered before the change is compiled")
+        self.expect_true('contract C' in response['result']['contents']['value'], "hover of the analyzed version")
+
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal([d['code'] for d in reports[0]['diagnostics']], [7576], "diagnostics of the new version")
+
+    def test_cancel_queued_request(self, solc: JsonRpcProcess) -> None:
+        """
+        A request that is still queued behind a long compilation is answered with an error
+        as soon as it is cancelled. The request being processed is answered as usual.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///a.sol'
+        functions = ''.join(
+            f'    function f{i}(uint a) public pure returns (uint) {{ return a + {i}; }}\n'
+            for i in range(3000)
+        )
+        self.open_virtual_file(
+            solc,
+            FILE_URI,
+            '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\ncontract C {\n' + functions + '}\n'
+        )
+        # The first request compiles the file, which keeps the server busy while the second
+        # request and its cancellation arrive.
+        solc.send_message('textDocument/semanticTokens/full', { 'textDocument': { 'uri': FILE_URI } }, message_id=1)
+        solc.send_message('textDocument/semanticTokens/full', { 'textDocument': { 'uri': FILE_URI } }, message_id=2)
+        solc.send_message('$/cancelRequest', { 'id': 2 })
+
+        responses = {}
+        while len(responses) < 2:
+            message = solc.receive_message()
+            assert message is not None
+            if 'id' in message and 'method' not in message:
+                responses[message['id']] = message
+
+        self.expect_true('result' in responses[1], "first request answered")
+        self.expect_true('error' in responses[2], "second request not answered")
+        self.expect_equal(responses[2]['error']['code'], -32800, "RequestCancelled")
+
     def test_textDocument_didOpen_with_relative_import_without_project_url(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc, expose_project_root=False)
         TEST_NAME = 'didOpen_with_import'
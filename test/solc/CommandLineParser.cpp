@@ -120,6 +120,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -131,6 +132,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
+			"--optimizer-profile",
 			"--gas",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
@@ -142,11 +144,15 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
 			"--model-checker-bmc-loop-iterations=2",
+			"--model-checker-cache=/tmp/smt-cache",
+			"--model-checker-cache-max-entries=100",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
+			"--model-checker-detect-solver-conflicts",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-jobs=3",
 			"--model-checker-show-proved-safe",
 			"--model-checker-show-unproved",
 			"--model-checker-show-unsupported",
@@ -179,6 +185,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.jobs = 4;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -192,7 +199,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -213,9 +220,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			2,
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
+			true,
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
+			3,
 			false, // --model-checker-print-query
 			true,
 			true,
@@ -224,6 +233,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
 		};
+		expectedOptions.modelChecker.cacheDirectory = "/tmp/smt-cache";
+		expectedOptions.modelChecker.cacheMaxEntries = 100;
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -423,13 +434,20 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=4", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--compilation-cache=/tmp/cache", {"--assemble", "--yul", "--strict-assembly", "--link", "--import-ast"}},
+		{"--compilation-cache-max-entries=10", {"--assemble", "--yul", "--strict-assembly", "--link", "--import-ast"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-cache=/tmp/smt-cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
+		{"--model-checker-cache-max-entries=10", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unsupported", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-detect-solver-conflicts", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-jobs=3", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
@@ -628,6 +646,52 @@ BOOST_AUTO_TEST_CASE(invalid_optimizer_sequence_without_optimize)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	CommandLineOptions options = parseCommandLine({"solc", "contract.sol", "--compilation-cache=/tmp/cache", "--compilation-cache-max-entries=10"});
+	BOOST_CHECK(options.output.compilationCacheDirectory == boost::filesystem::path("/tmp/cache"));
+	BOOST_CHECK_EQUAL(options.output.compilationCacheMaxEntries, 10);
+
+	options = parseCommandLine({"solc", "--standard-json", "--compilation-cache=/tmp/cache", "input.json"});
+	BOOST_CHECK(options.input.mode == InputMode::StandardJson);
+	BOOST_CHECK(options.output.compilationCacheDirectory == boost::filesystem::path("/tmp/cache"));
+
+	std::string const expectedErrorMessage{"--compilation-cache-max-entries can only be used together with --compilation-cache."};
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "contract.sol", "--compilation-cache-max-entries=10"}),
+		CommandLineValidationError,
+		hasCorrectMessage
+	);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache)
+{
+	CommandLineOptions options = parseCommandLine({"solc", "contract.sol", "--model-checker-cache=/tmp/smt-cache", "--model-checker-cache-max-entries=10"});
+	BOOST_CHECK(options.modelChecker.cacheDirectory == boost::filesystem::path("/tmp/smt-cache"));
+	BOOST_CHECK_EQUAL(options.modelChecker.cacheMaxEntries, 10);
+	// The cache does not change the settings of the model checker.
+	BOOST_CHECK(!options.modelChecker.initialize);
+
+	options = parseCommandLine({"solc", "--standard-json", "--model-checker-cache=/tmp/smt-cache", "input.json"});
+	BOOST_CHECK(options.input.mode == InputMode::StandardJson);
+	BOOST_CHECK(options.modelChecker.cacheDirectory == boost::filesystem::path("/tmp/smt-cache"));
+
+	auto hasMessage = [](std::string const& _expectedMessage) {
+		return [=](CommandLineValidationError const& _exception) { return _exception.what() == _expectedMessage; };
+	};
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "contract.sol", "--model-checker-cache="}),
+		CommandLineValidationError,
+		hasMessage("--model-checker-cache requires a non-empty path.")
+	);
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "contract.sol", "--model-checker-cache-max-entries=10"}),
+		CommandLineValidationError,
+		hasMessage("--model-checker-cache-max-entries can only be used together with --model-checker-cache.")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
@@ -107,10 +107,12 @@ void FuzzerUtil::testCompiler(
 		compiler.setModelCheckerSettings({
 			/*bmcLoopIterations*/1,
 			frontend::ModelCheckerContracts::Default(),
+			/*detectSolverConflicts=*/false,
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
 			frontend::ModelCheckerInvariants::All(),
+			/*jobs=*/1,
 			/*printQuery=*/false,
 			/*showProvedSafe=*/false,
 			/*showUnproved=*/false,